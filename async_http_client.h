@@ -0,0 +1,298 @@
+#pragma once
+
+#include <curl/curl.h>
+#include <cctype>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+enum class HttpMethod { Get, Post, Delete };
+
+/**
+ * @brief 非同步請求的完成結果
+ */
+struct HttpResponse {
+    uint64_t requestId;
+    CURLcode result;        // 傳輸層結果
+    long status;            // HTTP狀態碼，傳輸失敗時為0
+    std::string body;
+    int usedWeight;         // X-MBX-USED-WEIGHT-1M，未提供時為-1
+    int retryAfterSeconds;  // Retry-After，未提供時為0
+
+    bool ok() const { return result == CURLE_OK && status >= 200 && status < 300; }
+
+    std::string errorMessage() const {
+        if (result != CURLE_OK) {
+            return std::string("cURL Error: ") + curl_easy_strerror(result);
+        }
+        return "HTTP " + std::to_string(status) + ": " + body;
+    }
+};
+
+/**
+ * @brief 基於 libcurl multi 介面的非同步HTTP客戶端
+ *
+ * 在單一執行緒上同時推進多個請求：submit() 只登記請求，
+ * 由呼叫者反覆呼叫 poll() 推進傳輸並觸發完成回調。
+ * 所有請求共用 multi 句柄的連線池與DNS快取，HTTP/2下會多工復用同一連線。
+ * 已完成的 easy 句柄會回收重用。非執行緒安全。
+ */
+class AsyncHttpClient {
+public:
+    using Callback = std::function<void(const HttpResponse&)>;
+
+private:
+    struct Transfer {
+        CURL* easy;
+        std::string url;
+        std::string body;
+        HttpResponse response;
+        Callback callback;
+        bool busy;
+
+        Transfer() : easy(nullptr), busy(false) {}
+    };
+
+    CURLM* multi;
+    std::string baseUrl;
+    curl_slist* headers;
+    std::vector<std::unique_ptr<Transfer>> transfers;  // 位址穩定，供 CURLOPT_PRIVATE 使用
+    std::vector<Transfer*> freeList;
+    uint64_t nextRequestId;
+    size_t running;
+
+    static size_t writeCallback(void* contents, size_t size, size_t nmemb, std::string* output) {
+        size_t totalSize = size * nmemb;
+        output->append(static_cast<char*>(contents), totalSize);
+        return totalSize;
+    }
+
+    // 擷取限流相關的回應標頭
+    static size_t headerCallback(char* buffer, size_t size, size_t nitems, Transfer* transfer) {
+        size_t totalSize = size * nitems;
+        std::string_view line(buffer, totalSize);
+        if (startsWithIgnoreCase(line, "x-mbx-used-weight-1m:")) {
+            transfer->response.usedWeight = parseHeaderInt(line);
+        } else if (startsWithIgnoreCase(line, "retry-after:")) {
+            transfer->response.retryAfterSeconds = parseHeaderInt(line);
+        }
+        return totalSize;
+    }
+
+    static bool startsWithIgnoreCase(std::string_view line, std::string_view prefix) {
+        if (line.size() < prefix.size()) return false;
+        for (size_t i = 0; i < prefix.size(); i++) {
+            if (std::tolower(static_cast<unsigned char>(line[i])) != prefix[i]) return false;
+        }
+        return true;
+    }
+
+    static int parseHeaderInt(std::string_view line) {
+        size_t colon = line.find(':');
+        int value = 0;
+        for (size_t i = colon + 1; i < line.size(); i++) {
+            char c = line[i];
+            if (c >= '0' && c <= '9') {
+                value = value * 10 + (c - '0');
+            } else if (c != ' ' && c != '\t') {
+                break;
+            }
+        }
+        return value;
+    }
+
+public:
+    /**
+     * @param base 服務端根地址（例如："https://api.binance.com"）
+     * @param maxHostConnections 單一主機的最大並行連線數
+     */
+    explicit AsyncHttpClient(const std::string& base, long maxHostConnections = 8)
+        : multi(curl_multi_init())
+        , baseUrl(base)
+        , headers(nullptr)
+        , nextRequestId(0)
+        , running(0) {
+        if (!multi) {
+            throw std::runtime_error("cURL multi init failed");
+        }
+        curl_multi_setopt(multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+        curl_multi_setopt(multi, CURLMOPT_MAX_HOST_CONNECTIONS, maxHostConnections);
+    }
+
+    ~AsyncHttpClient() {
+        for (auto& transfer : transfers) {
+            if (transfer->busy) {
+                curl_multi_remove_handle(multi, transfer->easy);
+            }
+            curl_easy_cleanup(transfer->easy);
+        }
+        curl_multi_cleanup(multi);
+        curl_slist_free_all(headers);
+    }
+
+    AsyncHttpClient(const AsyncHttpClient&) = delete;
+    AsyncHttpClient& operator=(const AsyncHttpClient&) = delete;
+
+    // 加入所有請求都攜帶的標頭（例如："X-MBX-APIKEY: ..."）
+    void addDefaultHeader(const std::string& header) {
+        headers = curl_slist_append(headers, header.c_str());
+    }
+
+    /**
+     * @brief 登記一個請求，實際傳輸在 poll() 中進行
+     * @param method 請求方法
+     * @param pathAndQuery 路徑與查詢字串（複製到重用的傳輸緩衝區，呼叫者的緩衝區可立即重用）
+     * @param callback 完成回調，在 poll() 內呼叫
+     * @param body POST 請求體
+     * @return 請求編號，與回應中的 requestId 對應
+     */
+    uint64_t submit(HttpMethod method, std::string_view pathAndQuery, Callback callback,
+                    std::string_view body = {}) {
+        Transfer* transfer = acquireTransfer();
+        transfer->url.assign(baseUrl).append(pathAndQuery);
+        transfer->body.assign(body);
+        transfer->response.requestId = ++nextRequestId;
+        transfer->response.result = CURLE_OK;
+        transfer->response.status = 0;
+        transfer->response.body.clear();
+        transfer->response.usedWeight = -1;
+        transfer->response.retryAfterSeconds = 0;
+        transfer->callback = std::move(callback);
+
+        CURL* easy = transfer->easy;
+        curl_easy_setopt(easy, CURLOPT_URL, transfer->url.c_str());
+        curl_easy_setopt(easy, CURLOPT_HTTPHEADER, headers);
+        switch (method) {
+            case HttpMethod::Get:
+                curl_easy_setopt(easy, CURLOPT_CUSTOMREQUEST, nullptr);
+                curl_easy_setopt(easy, CURLOPT_HTTPGET, 1L);
+                break;
+            case HttpMethod::Post:
+                curl_easy_setopt(easy, CURLOPT_CUSTOMREQUEST, nullptr);
+                curl_easy_setopt(easy, CURLOPT_POSTFIELDS, transfer->body.c_str());
+                curl_easy_setopt(easy, CURLOPT_POSTFIELDSIZE, static_cast<long>(transfer->body.size()));
+                break;
+            case HttpMethod::Delete:
+                curl_easy_setopt(easy, CURLOPT_HTTPGET, 1L);
+                curl_easy_setopt(easy, CURLOPT_CUSTOMREQUEST, "DELETE");
+                break;
+        }
+
+        CURLMcode mres = curl_multi_add_handle(multi, easy);
+        if (mres != CURLM_OK) {
+            releaseTransfer(transfer);
+            throw std::runtime_error(std::string("cURL multi add failed: ") + curl_multi_strerror(mres));
+        }
+        transfer->busy = true;
+        running++;
+        return transfer->response.requestId;
+    }
+
+    /**
+     * @brief 推進所有進行中的傳輸，最多等待 timeoutMs 毫秒
+     * @return 本次完成的請求數
+     */
+    size_t poll(int timeoutMs) {
+        if (running == 0) return 0;
+
+        int stillRunning = 0;
+        curl_multi_perform(multi, &stillRunning);
+        size_t completed = collectCompleted();
+        if (completed > 0 || running == 0) {
+            return completed;
+        }
+
+        curl_multi_poll(multi, nullptr, 0, timeoutMs, nullptr);
+        curl_multi_perform(multi, &stillRunning);
+        return collectCompleted();
+    }
+
+    // 持續推進直到所有請求完成
+    void drain(int timeoutMs = 100) {
+        while (running > 0) {
+            poll(timeoutMs);
+        }
+    }
+
+    size_t inFlight() const { return running; }
+
+private:
+    Transfer* acquireTransfer() {
+        if (!freeList.empty()) {
+            Transfer* transfer = freeList.back();
+            freeList.pop_back();
+            return transfer;
+        }
+
+        auto transfer = std::make_unique<Transfer>();
+        transfer->easy = curl_easy_init();
+        if (!transfer->easy) {
+            throw std::runtime_error("cURL init failed");
+        }
+        transfer->response.body.reserve(4096);
+
+        CURL* easy = transfer->easy;
+        curl_easy_setopt(easy, CURLOPT_PRIVATE, transfer.get());
+        curl_easy_setopt(easy, CURLOPT_WRITEFUNCTION, writeCallback);
+        curl_easy_setopt(easy, CURLOPT_WRITEDATA, &transfer->response.body);
+        curl_easy_setopt(easy, CURLOPT_HEADERFUNCTION, headerCallback);
+        curl_easy_setopt(easy, CURLOPT_HEADERDATA, transfer.get());
+        curl_easy_setopt(easy, CURLOPT_NOSIGNAL, 1L);
+        curl_easy_setopt(easy, CURLOPT_HTTP_VERSION, (long)CURL_HTTP_VERSION_2TLS);
+        // 只有 HTTPS 會協商 HTTP/2；明文 HTTP/1.1 下等待復用會把並行請求排成一列
+        curl_easy_setopt(easy, CURLOPT_PIPEWAIT, baseUrl.compare(0, 8, "https://") == 0 ? 1L : 0L);
+        curl_easy_setopt(easy, CURLOPT_TCP_KEEPALIVE, 1L);
+        curl_easy_setopt(easy, CURLOPT_TCP_NODELAY, 1L);
+        curl_easy_setopt(easy, CURLOPT_DNS_CACHE_TIMEOUT, 3600L);
+        curl_easy_setopt(easy, CURLOPT_CONNECTTIMEOUT_MS, 5000L);
+        curl_easy_setopt(easy, CURLOPT_TIMEOUT_MS, 10000L);
+
+        transfers.push_back(std::move(transfer));
+        return transfers.back().get();
+    }
+
+    void releaseTransfer(Transfer* transfer) {
+        transfer->busy = false;
+        transfer->callback = nullptr;
+        freeList.push_back(transfer);
+    }
+
+    size_t collectCompleted() {
+        size_t completed = 0;
+        int remaining = 0;
+        while (CURLMsg* msg = curl_multi_info_read(multi, &remaining)) {
+            if (msg->msg != CURLMSG_DONE) continue;
+
+            Transfer* transfer = nullptr;
+            curl_easy_getinfo(msg->easy_handle, CURLINFO_PRIVATE, &transfer);
+            transfer->response.result = msg->data.result;
+            curl_easy_getinfo(msg->easy_handle, CURLINFO_RESPONSE_CODE, &transfer->response.status);
+            curl_multi_remove_handle(multi, msg->easy_handle);
+            running--;
+            completed++;
+
+            // 回調以引用取得回應，結束後才歸還句柄，回應體的緩衝區留在句柄中重用；
+            // 回調中提交的新請求會分配到其他句柄
+            Callback callback = std::move(transfer->callback);
+            try {
+                if (callback) {
+                    callback(transfer->response);
+                }
+            } catch (...) {
+                finishTransfer(transfer);
+                throw;
+            }
+            finishTransfer(transfer);
+        }
+        return completed;
+    }
+
+    void finishTransfer(Transfer* transfer) {
+        transfer->response.body.clear();
+        releaseTransfer(transfer);
+    }
+};
@@ -0,0 +1,69 @@
+// 非同步HTTP客戶端基準：伺服器每個回應延遲 20 ms 時，逐一同步發送與以 AsyncHttpClient 並行發送一批請求的總耗時，
+// 以及連續請求之間回應緩衝區的重用情況
+#include <curl/curl.h>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include "../async_http_client.h"
+#include "../http_client.h"
+#include "../tests/mock_exchange.h"
+
+namespace {
+
+constexpr int BATCH = 32;
+constexpr int REUSE_ROUNDS = 50;
+const char* PATH = "/api/v3/time";
+
+double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+}  // namespace
+
+int main() {
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+    MockExchange exchange("benchkey", "benchsecret");
+    exchange.setLatency(std::chrono::milliseconds(20));
+
+    HttpClient client(exchange.baseUrl());
+    client.warmUp(PATH);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < BATCH; i++) {
+        client.get(PATH);
+    }
+    double sequentialMs = elapsedMs(start);
+
+    int completed = 0;
+    {
+        AsyncHttpClient http(exchange.baseUrl(), BATCH);
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < BATCH; i++) {
+            http.submit(HttpMethod::Get, PATH, [&completed](const HttpResponse& response) {
+                completed += response.ok();
+            });
+        }
+        http.drain();
+    }
+    double asyncMs = elapsedMs(start);
+
+    // 完成的傳輸回收後，下一個請求沿用同一個回應緩衝區
+    exchange.setLatency(std::chrono::milliseconds(0));
+    AsyncHttpClient http(exchange.baseUrl());
+    const char* lastBody = nullptr;
+    int reused = 0;
+    for (int i = 0; i < REUSE_ROUNDS; i++) {
+        http.submit(HttpMethod::Get, PATH, [&](const HttpResponse& response) {
+            completed += response.ok();
+            if (response.body.data() == lastBody) reused++;
+            lastBody = response.body.data();
+        });
+        http.drain();
+    }
+
+    std::printf("%d requests, 20 ms server latency: sequential %.1f ms, async %.1f ms\n",
+                BATCH, sequentialMs, asyncMs);
+    std::printf("response buffer reused: %d of %d\n", reused, REUSE_ROUNDS - 1);
+    std::printf("completed: %d of %d\n", completed, BATCH + REUSE_ROUNDS);
+    curl_global_cleanup();
+    return completed == BATCH + REUSE_ROUNDS ? 0 : 1;
+}
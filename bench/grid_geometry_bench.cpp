@@ -0,0 +1,41 @@
+// 網格幾何基準：等差與等比模式下 indexOf 與 levelPrice 的單次耗時
+#include <chrono>
+#include <cstdio>
+#include "../grid_geometry.h"
+
+namespace {
+
+constexpr int ITERATIONS = 10000000;
+
+volatile double doubleSink;
+volatile long long indexSink;
+
+void run(const char* name, const GridGeometry& geometry, double basePrice) {
+    long long baseIndex = geometry.indexOf(basePrice);
+
+    auto start = std::chrono::steady_clock::now();
+    long long indexSum = 0;
+    for (int i = 0; i < ITERATIONS; i++) {
+        indexSum += geometry.indexOf(basePrice + (i & 1023) * 0.01);
+    }
+    auto middle = std::chrono::steady_clock::now();
+    double priceSum = 0;
+    for (int i = 0; i < ITERATIONS; i++) {
+        priceSum += geometry.levelPrice(baseIndex + (i & 1023));
+    }
+    auto end = std::chrono::steady_clock::now();
+    indexSink = indexSum;
+    doubleSink = priceSum;
+
+    double indexNs = std::chrono::duration<double, std::nano>(middle - start).count() / ITERATIONS;
+    double priceNs = std::chrono::duration<double, std::nano>(end - middle).count() / ITERATIONS;
+    std::printf("%-10s indexOf %6.2f ns/op, levelPrice %6.2f ns/op\n", name, indexNs, priceNs);
+}
+
+}  // namespace
+
+int main() {
+    run("arithmetic", GridGeometry(GridGeometry::Mode::Arithmetic, 1.0, false, 0, 0), 3000);
+    run("geometric", GridGeometry(GridGeometry::Mode::Geometric, 0.005, false, 0, 0), 3000);
+    return 0;
+}
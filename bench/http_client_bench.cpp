@@ -0,0 +1,66 @@
+// HTTP 客戶端基準：每次請求新建 cURL 句柄（每次重新握手）與長連線 HttpClient 的單次請求耗時
+// 用法：http_client_bench [根地址 路徑]，預設對本機模擬交易所的 /api/v3/time
+#include <curl/curl.h>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include "../http_client.h"
+#include "../tests/mock_exchange.h"
+
+namespace {
+
+constexpr int REQUESTS = 500;
+
+size_t discard(void*, size_t size, size_t nmemb, void*) {
+    return size * nmemb;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+    std::unique_ptr<MockExchange> exchange;
+    std::string baseUrl;
+    std::string path = "/api/v3/time";
+    if (argc >= 3) {
+        baseUrl = argv[1];
+        path = argv[2];
+    } else {
+        exchange = std::make_unique<MockExchange>("benchkey", "benchsecret");
+        baseUrl = exchange->baseUrl();
+    }
+    std::string url = baseUrl + path;
+
+    int failures = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < REQUESTS; i++) {
+        CURL* curl = curl_easy_init();
+        curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, discard);
+        if (curl_easy_perform(curl) != CURLE_OK) failures++;
+        curl_easy_cleanup(curl);
+    }
+    auto middle = std::chrono::steady_clock::now();
+
+    HttpClient client(baseUrl);
+    client.warmUp(path);
+    auto warmed = std::chrono::steady_clock::now();
+    for (int i = 0; i < REQUESTS; i++) {
+        try {
+            client.get(path);
+        } catch (const std::runtime_error&) {
+            failures++;
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    std::printf("%s\n", url.c_str());
+    std::printf("new handle per request: %8.1f us/req\n",
+                std::chrono::duration<double, std::micro>(middle - start).count() / REQUESTS);
+    std::printf("persistent HttpClient:  %8.1f us/req\n",
+                std::chrono::duration<double, std::micro>(end - warmed).count() / REQUESTS);
+    std::printf("failures: %d\n", failures);
+    curl_global_cleanup();
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,125 @@
+// 訂單記錄基準：10 萬筆訂單下，原先以字串保存ID與方向的記錄與定長 Order 的記憶體佔用、
+// 按方向檢查活躍訂單的耗時，以及訂單ID的生成成本
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+#include "../object_pool.h"
+#include "../order_id.h"
+#include "../order_record.h"
+
+namespace {
+
+constexpr int ORDERS = 100000;
+constexpr int ROUNDS = 50;
+constexpr int LOOKUPS = 10000000;
+
+// 改為定長記錄之前的訂單結構
+struct LegacyOrder {
+    std::string orderId;
+    std::string side;
+    double price;
+    double quantity;
+    double gridLevel;
+    bool isOpen;
+};
+
+// 超出短字串優化、存放在堆上的字元數
+size_t heapBytes(const std::string& text) {
+    return text.capacity() > std::string().capacity() ? text.capacity() + 1 : 0;
+}
+
+double elapsedNs(std::chrono::steady_clock::time_point start, double count) {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / count;
+}
+
+volatile long long sink;
+
+}  // namespace
+
+int main() {
+    std::vector<LegacyOrder> legacy;
+    legacy.reserve(ORDERS);
+    size_t legacyHeap = 0;
+    for (int i = 0; i < ORDERS; i++) {
+        legacy.push_back(LegacyOrder{"ORDER_" + std::to_string(1700000000000LL + i), i % 2 ? "sell" : "buy",
+                                     3000 + i * 0.01, 0.01, 3000.0 + i % 1000, i % 10 == 0});
+        legacyHeap += heapBytes(legacy.back().orderId) + heapBytes(legacy.back().side);
+    }
+
+    OrderIdGenerator ids;
+    ObjectPool<Order> pool(0);
+    std::vector<PoolHandle> handles;
+    for (int i = 0; i < ORDERS; i++) {
+        uint8_t status = i % 10 == 0 ? ORDER_OPEN : ORDER_CLOSED;
+        handles.push_back(pool.acquire(Order{ids.next(0, i % 1000), Price::fromUnits(300000 + i), Quantity::fromUnits(100),
+                                             Price::fromUnits(300000 + i % 1000 * 100),
+                                             i % 2 ? OrderSide::Sell : OrderSide::Buy, status}));
+    }
+
+    std::printf("record size: legacy %zu bytes, Order %zu bytes\n", sizeof(LegacyOrder), sizeof(Order));
+    std::printf("%d orders: legacy %.2f MB (+%.2f MB heap strings), Order %.2f MB\n", ORDERS,
+                sizeof(LegacyOrder) * ORDERS / 1e6, legacyHeap / 1e6, sizeof(Order) * ORDERS / 1e6);
+
+    // 逐筆掃描：字串比較方向與位元檢查方向
+    long long hits = 0;
+    const std::string buy = "buy";
+    const std::string sell = "sell";
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < ROUNDS; round++) {
+        const std::string& side = round % 2 ? sell : buy;
+        for (const LegacyOrder& order : legacy) {
+            if (order.isOpen && order.side == side) hits++;
+        }
+    }
+    double legacyScanNs = elapsedNs(start, double(ROUNDS) * ORDERS);
+
+    start = std::chrono::steady_clock::now();
+    for (int round = 0; round < ROUNDS; round++) {
+        OrderSide side = round % 2 ? OrderSide::Sell : OrderSide::Buy;
+        for (PoolHandle handle : handles) {
+            const Order& order = pool.get(handle);
+            if (order.isOpen() && order.side == side) hits++;
+        }
+    }
+    double scanNs = elapsedNs(start, double(ROUNDS) * ORDERS);
+
+    // 以句柄隨機檢查單筆訂單，對應網格線上的下單檢查
+    std::mt19937 random(1);
+    std::vector<PoolHandle> probes(4096);
+    for (PoolHandle& probe : probes) probe = handles[random() % ORDERS];
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < LOOKUPS; i++) {
+        const Order& order = pool.get(probes[i & 4095]);
+        if (order.isOpen() && order.side == OrderSide::Buy) hits++;
+    }
+    double lookupNs = elapsedNs(start, LOOKUPS);
+
+    // 訂單ID：字串拼接與64位整數（只在交易所邊界編碼成字串）
+    start = std::chrono::steady_clock::now();
+    size_t length = 0;
+    for (int i = 0; i < ORDERS; i++) {
+        std::string id = "ORDER_" + std::to_string(1700000000000LL + i);
+        length += id.size();
+    }
+    double stringIdNs = elapsedNs(start, ORDERS);
+    start = std::chrono::steady_clock::now();
+    uint64_t idSum = 0;
+    for (int i = 0; i < ORDERS; i++) {
+        idSum += ids.next(0, i);
+    }
+    double integerIdNs = elapsedNs(start, ORDERS);
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ORDERS; i++) {
+        length += OrderIdGenerator::encode(idSum + i).text[0];
+    }
+    double encodeNs = elapsedNs(start, ORDERS);
+    sink = hits + static_cast<long long>(length + idSum);
+
+    std::printf("open-order scan: legacy %.2f ns/order, Order %.2f ns/order\n", legacyScanNs, scanNs);
+    std::printf("handle check: %.2f ns\n", lookupNs);
+    std::printf("order id: string %.1f ns, integer %.1f ns, encode at exchange boundary %.1f ns\n",
+                stringIdNs, integerIdNs, encodeNs);
+    return 0;
+}
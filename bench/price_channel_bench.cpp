@@ -0,0 +1,135 @@
+// 價格通道基準：SpscRing 吞吐量、PriceChannel 的交接延遲（p50/p99），
+// 以及策略執行緒落後時的合併：每個交易對依序交付、最後一筆一定送達，且處理數加合併數等於發布數
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+#include "../price_channel.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t THROUGHPUT_EVENTS = 5000000;
+constexpr size_t LATENCY_EVENTS = 200000;
+constexpr size_t CONFLATION_EVENTS = 2000000;
+constexpr uint32_t CONFLATION_PAIRS = 8;
+
+long long nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+void spin(long long ns) {
+    long long start = nowNs();
+    while (nowNs() - start < ns) {
+    }
+}
+
+double throughput() {
+    SpscRing<PriceEvent> ring(4096);
+    uint64_t checksum = 0;
+    auto start = Clock::now();
+    std::thread consumer([&]() {
+        size_t received = 0;
+        while (received < THROUGHPUT_EVENTS) {
+            received += ring.popBatch([&checksum](const PriceEvent& event) { checksum += event.sequence; }, 256);
+        }
+    });
+    for (size_t i = 1; i <= THROUGHPUT_EVENTS; i++) {
+        PriceEvent event{0, i, 1, 0, 0, 0};
+        while (!ring.tryPush(event)) {
+            std::this_thread::yield();
+        }
+    }
+    consumer.join();
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return checksum == THROUGHPUT_EVENTS * (THROUGHPUT_EVENTS + 1) / 2 ? THROUGHPUT_EVENTS / seconds : 0;
+}
+
+// 生產者每 2 微秒發布一筆，eventTime 借用為發布時刻（奈秒），消費者以與引擎相同的退避等待
+std::vector<long long> handoffLatency() {
+    PriceChannel channel(4096, 1, false);
+    std::vector<long long> latencies;
+    latencies.reserve(LATENCY_EVENTS);
+    std::thread consumer([&]() {
+        std::vector<PriceEvent> batch;
+        IdleBackoff backoff(std::chrono::microseconds(50));
+        while (latencies.size() < LATENCY_EVENTS) {
+            if (channel.consume(batch, 256) == 0) {
+                backoff.idle();
+                continue;
+            }
+            backoff.reset();
+            long long received = nowNs();
+            for (const PriceEvent& event : batch) {
+                latencies.push_back(received - event.eventTime);
+            }
+        }
+    });
+    for (size_t i = 1; i <= LATENCY_EVENTS; i++) {
+        channel.publish(PriceEvent{0, i, 1, 0, 0, nowNs()});
+        spin(2000);
+    }
+    consumer.join();
+    std::sort(latencies.begin(), latencies.end());
+    return latencies;
+}
+
+}  // namespace
+
+int main() {
+    if (std::thread::hardware_concurrency() < 2) {
+        std::printf("note: single CPU, producer and consumer share a core; latencies reflect scheduling, not the ring\n");
+    }
+    double eventsPerSecond = throughput();
+    std::printf("SpscRing throughput: %.1f M events/s\n", eventsPerSecond / 1e6);
+
+    std::vector<long long> latencies = handoffLatency();
+    std::printf("PriceChannel handoff (2 us pacing): p50 %lld ns, p99 %lld ns, max %lld ns\n",
+                latencies[latencies.size() / 2], latencies[latencies.size() * 99 / 100], latencies.back());
+
+    // 策略執行緒每筆事件耗時 1 微秒，生產者全速發布
+    PriceChannel channel(64, CONFLATION_PAIRS, true);
+    std::atomic<bool> done(false);
+    std::vector<uint64_t> lastDelivered(CONFLATION_PAIRS, 0);
+    uint64_t processed = 0;
+    bool ordered = true;
+    std::thread consumer([&]() {
+        std::vector<PriceEvent> batch;
+        while (true) {
+            bool finished = done.load();
+            if (channel.consume(batch, 256) == 0) {
+                if (finished) break;
+                std::this_thread::yield();
+                continue;
+            }
+            for (const PriceEvent& event : batch) {
+                if (event.sequence <= lastDelivered[event.pair]) ordered = false;
+                lastDelivered[event.pair] = event.sequence;
+                processed++;
+                spin(1000);
+            }
+        }
+    });
+    std::vector<uint64_t> published(CONFLATION_PAIRS, 0);
+    for (size_t i = 0; i < CONFLATION_EVENTS; i++) {
+        uint32_t pair = static_cast<uint32_t>(i % CONFLATION_PAIRS);
+        channel.publish(PriceEvent{pair, ++published[pair], 1, 0, 0, 0});
+    }
+    done = true;
+    consumer.join();
+
+    uint64_t conflated = 0;
+    bool latestDelivered = true;
+    for (uint32_t pair = 0; pair < CONFLATION_PAIRS; pair++) {
+        conflated += channel.conflatedCount(pair);
+        if (lastDelivered[pair] != published[pair]) latestDelivered = false;
+    }
+    std::printf("conflation: published %zu, processed %llu, conflated %llu, in order %s, latest delivered %s\n",
+                CONFLATION_EVENTS, static_cast<unsigned long long>(processed),
+                static_cast<unsigned long long>(conflated), ordered ? "yes" : "no", latestDelivered ? "yes" : "no");
+    bool accounted = processed + conflated == CONFLATION_EVENTS;
+    return eventsPerSecond > 0 && ordered && latestDelivered && accounted ? 0 : 1;
+}
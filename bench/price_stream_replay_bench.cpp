@@ -0,0 +1,111 @@
+// 行情流重播：以本機 WebSocket 模擬端重播錄下的行情訊息，驗證 PriceStream 逐筆依序交付、
+// 斷線後自動重連並重新訂閱，並統計解析與回調的耗時
+// 用法：price_stream_replay_bench [錄檔 [交易對]]，錄檔每行一筆 trade 或 bookTicker 原始訊息；
+// 預設重播 2000 筆合成的 ETHUSDT bookTicker，每 500 筆斷線一次
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../price_stream.h"
+#include "../tests/mock_stream_server.h"
+
+namespace {
+
+constexpr size_t SYNTHETIC_TICKS = 2000;
+constexpr size_t DROP_EVERY = 500;
+
+// 訊息對應的成交價或買賣中間價，不是行情訊息時回傳 false
+bool expectedPrice(const std::string& message, double& price) {
+    nlohmann::json data = nlohmann::json::parse(message, nullptr, false);
+    if (!data.is_object() || !data.contains("s") || data.contains("U")) return false;
+    if (data.contains("b") && data.contains("a")) {
+        price = (std::stod(data["b"].get<std::string>()) + std::stod(data["a"].get<std::string>())) / 2;
+        return true;
+    }
+    if (data.contains("p")) {
+        price = std::stod(data["p"].get<std::string>());
+        return true;
+    }
+    return false;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> messages;
+    std::string symbol = argc >= 3 ? argv[2] : "ETHUSDT";
+    if (argc >= 2) {
+        std::ifstream file(argv[1]);
+        if (!file) {
+            std::fprintf(stderr, "Cannot open %s\n", argv[1]);
+            return 1;
+        }
+        for (std::string line; std::getline(file, line);) {
+            if (!line.empty()) messages.push_back(line);
+        }
+    } else {
+        for (size_t i = 0; i < SYNTHETIC_TICKS; i++) {
+            char message[160];
+            double price = 3000 + static_cast<double>(i) * 0.35;
+            std::snprintf(message, sizeof(message),
+                          "{\"u\":%zu,\"s\":\"ETHUSDT\",\"b\":\"%.2f\",\"B\":\"1\",\"a\":\"%.2f\",\"A\":\"1\"}",
+                          i, price - 0.01, price + 0.01);
+            messages.push_back(message);
+        }
+    }
+
+    std::vector<double> expected;
+    for (const std::string& message : messages) {
+        double price = 0;
+        if (expectedPrice(message, price)) expected.push_back(price);
+    }
+    if (expected.empty()) {
+        std::fprintf(stderr, "No trade or bookTicker messages to replay\n");
+        return 1;
+    }
+
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+    MockStreamServer server(messages, argc >= 2 ? 0 : DROP_EVERY);
+    PriceStream stream(server.baseUrl(), "bookTicker");
+    stream.subscribe(symbol);
+
+    size_t received = 0;
+    size_t mismatches = 0;
+    std::vector<double> gapsNs;  // 相鄰兩次回調的間隔，含重連退避
+    gapsNs.reserve(expected.size());
+    auto lastCallback = std::chrono::steady_clock::now();
+    auto start = lastCallback;
+    std::thread worker([&]() {
+        stream.run([&](const PriceUpdate& update) {
+            auto now = std::chrono::steady_clock::now();
+            if (received < expected.size() && update.price != expected[received]) mismatches++;
+            if (received > 0) gapsNs.push_back(std::chrono::duration<double, std::nano>(now - lastCallback).count());
+            received++;
+            lastCallback = now;
+            if (received == expected.size()) stream.stop();
+        });
+    });
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(60);
+    while (received < expected.size() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    stream.stop();
+    worker.join();
+    double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("replayed %zu messages, %zu updates expected, %zu received, %zu price mismatches\n",
+                messages.size(), expected.size(), received, mismatches);
+    std::printf("connections: %zu (reconnect backoff included in %.0f ms total)\n", server.subscribeCount(), elapsedMs);
+    if (!gapsNs.empty()) {
+        std::sort(gapsNs.begin(), gapsNs.end());
+        std::printf("gap between callbacks: p50 %.1f us, p99 %.1f us\n",
+                    gapsNs[gapsNs.size() / 2] / 1000, gapsNs[gapsNs.size() * 99 / 100] / 1000);
+    }
+    curl_global_cleanup();
+    return received == expected.size() && mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,87 @@
+// 行情解析基準：TickerParser 與 nlohmann::json + std::stod 解析 /api/v3/ticker/price 回應的單次耗時，
+// 並以 strtod 核對解析出的價格
+#include <nlohmann/json.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+#include "../ticker_parser.h"
+
+namespace {
+
+constexpr int ITERATIONS = 1000000;
+constexpr int SAMPLES = 1000;
+
+double elapsedNs(std::chrono::steady_clock::time_point start, int count) {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / count;
+}
+
+}  // namespace
+
+int main() {
+    std::mt19937_64 random(1);
+    std::uniform_real_distribution<double> prices(0.0001, 100000);
+    std::vector<std::string> bodies;
+    for (int i = 0; i < SAMPLES; i++) {
+        char body[128];
+        std::snprintf(body, sizeof(body), "{\"symbol\":\"ETHUSDT\",\"price\":\"%.8f\"}", prices(random));
+        bodies.push_back(body);
+    }
+    std::string array = "[";
+    for (int i = 0; i < 20; i++) {
+        if (i > 0) array += ",";
+        array += bodies[i];
+    }
+    array += "]";
+
+    int mismatches = 0;
+    for (const std::string& body : bodies) {
+        std::string_view symbol;
+        std::string_view priceText;
+        double price = 0;
+        if (!TickerParser::parse(body, symbol, priceText, price)
+            || price != std::strtod(std::string(priceText).c_str(), nullptr)) {
+            mismatches++;
+        }
+    }
+
+    double sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; i++) {
+        nlohmann::json json = nlohmann::json::parse(bodies[i % SAMPLES]);
+        sum += std::stod(json["price"].get<std::string>());
+    }
+    double jsonNs = elapsedNs(start, ITERATIONS);
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; i++) {
+        std::string_view symbol;
+        std::string_view priceText;
+        double price = 0;
+        TickerParser::parse(bodies[i % SAMPLES], symbol, priceText, price);
+        sum += price;
+    }
+    double parserNs = elapsedNs(start, ITERATIONS);
+
+    constexpr int ARRAY_ITERATIONS = ITERATIONS / 20;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ARRAY_ITERATIONS; i++) {
+        for (const nlohmann::json& ticker : nlohmann::json::parse(array)) {
+            sum += std::stod(ticker["price"].get<std::string>());
+        }
+    }
+    double jsonArrayNs = elapsedNs(start, ARRAY_ITERATIONS);
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ARRAY_ITERATIONS; i++) {
+        TickerParser::parseArray(array, [&sum](std::string_view, double price) { sum += price; });
+    }
+    double parserArrayNs = elapsedNs(start, ARRAY_ITERATIONS);
+
+    std::printf("single ticker: json+stod %7.1f ns, TickerParser %7.1f ns\n", jsonNs, parserNs);
+    std::printf("20 tickers:    json+stod %7.1f ns, TickerParser %7.1f ns\n", jsonArrayNs, parserArrayNs);
+    std::printf("price mismatches against strtod: %d of %d (checksum %g)\n", mismatches, SAMPLES, sum);
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,475 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "async_http_client.h"
+#include "fixed_decimal.h"
+#include "hmac_signer.h"
+#include "order_gateway.h"
+#include "order_id.h"
+
+/**
+ * @brief 在預分配緩衝區中組裝並簽名的查詢字串
+ *
+ * 緩衝區可帶一段不參與簽名的前綴（例如 "/api/v3/order?"），之後的參數按加入順序以 & 連接，
+ * sign() 對參數部分計算 HMAC-SHA256 並附加 signature。組裝過程不分配記憶體。
+ * 參數值不做URL編碼，只用於交易對、枚舉值、數字與訂單ID這類不含保留字元的值。
+ */
+class SignedQuery {
+private:
+    static constexpr size_t CAPACITY = 1024;
+
+    char buffer[CAPACITY];
+    size_t length;
+    size_t payloadStart;  // 參與簽名的參數起點
+
+    void append(const char* data, size_t count) {
+        if (length + count > CAPACITY) {
+            throw std::runtime_error("Signed query too long");
+        }
+        std::memcpy(buffer + length, data, count);
+        length += count;
+    }
+
+    void appendKey(const char* name) {
+        if (length > payloadStart) append("&", 1);
+        append(name, std::strlen(name));
+        append("=", 1);
+    }
+
+public:
+    SignedQuery()
+        : length(0)
+        , payloadStart(0) {}
+
+    SignedQuery(const SignedQuery&) = delete;
+    SignedQuery& operator=(const SignedQuery&) = delete;
+
+    // 清空並寫入不參與簽名的前綴
+    SignedQuery& reset(std::string_view prefix = {}) {
+        length = 0;
+        append(prefix.data(), prefix.size());
+        payloadStart = length;
+        return *this;
+    }
+
+    SignedQuery& add(const char* name, std::string_view value) {
+        appendKey(name);
+        append(value.data(), value.size());
+        return *this;
+    }
+
+    SignedQuery& add(const char* name, long long value) {
+        appendKey(name);
+        char digits[24];
+        auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        append(digits, static_cast<size_t>(result.ptr - digits));
+        return *this;
+    }
+
+    // 以定點數的最小單位與小數位數寫入十進位數字（例如 300050 與 2 位 -> "3000.50"）
+    SignedQuery& addDecimal(const char* name, int64_t units, int decimals) {
+        appendKey(name);
+        uint64_t magnitude = units < 0 ? 0 - static_cast<uint64_t>(units) : static_cast<uint64_t>(units);
+        char digits[32];
+        int count = static_cast<int>(std::to_chars(digits, digits + sizeof(digits), magnitude).ptr - digits);
+        if (units < 0) append("-", 1);
+        if (count <= decimals) {
+            append("0.", decimals > 0 ? 2 : 1);
+            for (int i = count; i < decimals; i++) append("0", 1);
+            append(digits, static_cast<size_t>(count));
+            return *this;
+        }
+        append(digits, static_cast<size_t>(count - decimals));
+        if (decimals > 0) {
+            append(".", 1);
+            append(digits + count - decimals, static_cast<size_t>(decimals));
+        }
+        return *this;
+    }
+
+    // 附加參數部分的簽名，回傳包含前綴的完整字串（在下一次 reset() 前有效）
+    std::string_view sign(HmacSha256Signer& signer) {
+        size_t payloadEnd = length;
+        appendKey("signature");
+        if (length + HmacSha256Signer::HEX_LENGTH > CAPACITY) {
+            throw std::runtime_error("Signed query too long");
+        }
+        signer.sign(buffer + payloadStart, payloadEnd - payloadStart, buffer + length);
+        length += HmacSha256Signer::HEX_LENGTH;
+        return view();
+    }
+
+    std::string_view view() const { return std::string_view(buffer, length); }
+};
+
+/**
+ * @brief 幣安現貨訂單 REST 客戶端（下單、撤單、改單、查詢），請求以 HMAC-SHA256 簽名
+ *
+ * 請求經 AsyncHttpClient 非同步送出，回應在 poll() 內轉為 OrderReply 交給回報處理函數，
+ * 供訂單閘道作為傳輸層使用；所有方法都只能在同一個執行緒上呼叫。
+ * timestamp 以本地時鐘加上與伺服器的時差計算：建構後先以 syncClock() 校時，
+ * 之後每5分鐘、以及收到 -1021（timestamp 超出 recvWindow）時在背景重新校時。
+ * 傳輸失敗或伺服器回 5xx 時訂單狀態未知，改以 newClientOrderId 查詢實際狀態後再回報；
+ * 查詢也無法確定時不回報，每秒重新查詢，訂單在策略端保持原狀，避免在同一網格線重複下單。
+ * 撤單回 -2011 時訂單可能已成交，同樣查詢後按實際狀態回報，成交由此送回策略記帳。
+ * 成交回報帶交易所的累計成交數量與金額，由訂單閘道換算為新增部分。
+ * OrderAction::Query 請求（閘道輪詢掛單）同樣以 newClientOrderId 查詢，掛單期間的成交因此能及時回報。
+ */
+class BinanceOrderClient {
+public:
+    using ReplyHandler = std::function<void(const OrderReply&)>;
+
+private:
+    // 交易對與其價格、數量的小數位數
+    struct Market {
+        std::string symbol;
+        DecimalScale scale;
+    };
+
+    static constexpr long long CLOCK_SYNC_INTERVAL_MS = 5 * 60 * 1000;
+    static constexpr long long CLOCK_RETRY_MS = 10 * 1000;
+    static constexpr long long QUERY_RETRY_MS = 1000;
+    static constexpr int TIMESTAMP_OUTSIDE_RECV_WINDOW = -1021;
+    static constexpr int CANCEL_REJECTED = -2011;
+
+    // 狀態仍未知、稍後重新查詢的訂單
+    struct PendingQuery {
+        uint32_t strategy;
+        uint64_t orderId;
+        OrderAction action;
+        long long dueMs;
+    };
+
+    AsyncHttpClient http;
+    HmacSha256Signer signer;
+    SignedQuery query;            // 重用的查詢字串緩衝區
+    std::vector<Market> markets;  // 策略下標 -> 交易對
+    ReplyHandler onReply;
+    std::vector<PendingQuery> pendingQueries;
+    std::vector<PendingQuery> dueQueries;  // 重用的到期查詢批次
+    long long recvWindowMs;
+    long long clockOffsetMs;      // 伺服器時間 - 本地時間
+    long long nextClockSyncMs;    // 下一次背景校時的本地時間，0 表示立即
+    bool clockSyncPending;
+    bool clockSynced;
+
+public:
+    /**
+     * @param baseUrl REST 根地址（例如："https://api.binance.com"）
+     * @param apiKey API key，以 X-MBX-APIKEY 標頭送出
+     * @param apiSecret API secret，只用於設定簽名密鑰
+     * @param recvWindow 請求有效時間窗口（毫秒）
+     */
+    BinanceOrderClient(const std::string& baseUrl, const std::string& apiKey, const std::string& apiSecret,
+                       long long recvWindow)
+        : http(baseUrl)
+        , signer(apiSecret)
+        , recvWindowMs(recvWindow)
+        , clockOffsetMs(0)
+        , nextClockSyncMs(0)
+        , clockSyncPending(false)
+        , clockSynced(false) {
+        http.addDefaultHeader("X-MBX-APIKEY: " + apiKey);
+    }
+
+    BinanceOrderClient(const BinanceOrderClient&) = delete;
+    BinanceOrderClient& operator=(const BinanceOrderClient&) = delete;
+
+    // 登記交易對，登記順序即 OrderRequest::strategy 的下標
+    void addMarket(const std::string& symbol, const DecimalScale& scale) {
+        markets.push_back(Market{symbol, scale});
+    }
+
+    void setReplyHandler(ReplyHandler handler) {
+        onReply = std::move(handler);
+    }
+
+    long long getClockOffsetMs() const { return clockOffsetMs; }
+
+    /**
+     * @brief 阻塞地向伺服器校時
+     * @throws std::runtime_error 無法取得伺服器時間
+     */
+    void syncClock() {
+        requestClockSync();
+        http.drain();
+        if (!clockSynced) {
+            throw std::runtime_error("Exchange clock sync failed");
+        }
+    }
+
+    // 送出一筆訂單請求；組裝或登記失敗時直接回報拒絕
+    void send(const OrderRequest& request) {
+        try {
+            switch (request.action) {
+                case OrderAction::New:
+                    placeOrder(request);
+                    break;
+                case OrderAction::Cancel:
+                    cancelOrder(request);
+                    break;
+                case OrderAction::Amend:
+                    replaceOrder(request);
+                    break;
+                case OrderAction::Query:
+                    queryOrder(request.strategy, request.orderId, OrderAction::Query);
+                    break;
+            }
+        } catch (const std::runtime_error& error) {
+            reply(OrderReply::make(request.orderId, OrderReplyType::Rejected, request.action, 0, error.what()));
+        }
+    }
+
+    /**
+     * @brief 以 newClientOrderId 查詢訂單，按當前狀態回報；訂單不存在時回報拒絕
+     * @param action 觸發查詢的請求，回報時原樣帶回
+     */
+    void queryOrder(uint32_t strategy, uint64_t orderId, OrderAction action) {
+        try {
+            const Market& market = markets[strategy];
+            query.reset("/api/v3/order?")
+                .add("symbol", market.symbol)
+                .add("origClientOrderId", OrderIdGenerator::encode(orderId).c_str());
+            http.submit(HttpMethod::Get, signQuery(), [this, strategy, orderId, action](const HttpResponse& response) {
+                if (statusUnknown(response)) {
+                    std::cerr << "Order " << OrderIdGenerator::encode(orderId) << " status unknown ("
+                              << response.errorMessage() << "), querying again" << std::endl;
+                    pendingQueries.push_back(PendingQuery{strategy, orderId, action, nowMs() + QUERY_RETRY_MS});
+                    return;
+                }
+                handleOrderResponse(strategy, orderId, action, response);
+            });
+        } catch (const std::runtime_error& error) {
+            reply(OrderReply::make(orderId, OrderReplyType::Rejected, action, 0, error.what()));
+        }
+    }
+
+    /**
+     * @brief 推進進行中的請求並觸發回報，不阻塞；到期時在背景重新校時並重新查詢狀態未知的訂單
+     * @return 本次完成的請求數
+     */
+    size_t poll() {
+        long long now = nowMs();
+        if (!clockSyncPending && now >= nextClockSyncMs) {
+            requestClockSync();
+        }
+        if (!pendingQueries.empty()) {
+            retryQueries(now);
+        }
+        return http.poll(0);
+    }
+
+private:
+    static long long nowMs() {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    // 傳輸失敗或 5xx：請求可能已被執行
+    static bool statusUnknown(const HttpResponse& response) {
+        return response.result != CURLE_OK || response.status >= 500;
+    }
+
+    void reply(const OrderReply& orderReply) {
+        if (onReply) onReply(orderReply);
+    }
+
+    void retryQueries(long long now) {
+        dueQueries.clear();
+        auto notDue = std::partition(pendingQueries.begin(), pendingQueries.end(),
+                                     [now](const PendingQuery& pending) { return pending.dueMs > now; });
+        dueQueries.assign(notDue, pendingQueries.end());
+        pendingQueries.erase(notDue, pendingQueries.end());
+        for (const PendingQuery& pending : dueQueries) {
+            queryOrder(pending.strategy, pending.orderId, pending.action);
+        }
+    }
+
+    // 交易所錯誤回應中的錯誤碼，沒有時為0
+    static int errorCode(const nlohmann::json& body) {
+        if (body.is_object() && body.contains("code") && body["code"].is_number_integer()) {
+            return body["code"].get<int>();
+        }
+        return 0;
+    }
+
+    // 附加 recvWindow、timestamp 與簽名
+    std::string_view signQuery() {
+        query.add("recvWindow", recvWindowMs).add("timestamp", nowMs() + clockOffsetMs);
+        return query.sign(signer);
+    }
+
+    // 限價單的共同參數
+    void addLimitOrder(const Market& market, const OrderRequest& request) {
+        query.add("side", request.side == OrderSide::Buy ? "BUY" : "SELL")
+            .add("type", "LIMIT")
+            .add("timeInForce", "GTC")
+            .addDecimal("quantity", request.quantity.raw(), market.scale.getQuantityDecimals())
+            .addDecimal("price", request.price.raw(), market.scale.getPriceDecimals())
+            .add("newClientOrderId", OrderIdGenerator::encode(request.orderId).c_str())
+            .add("newOrderRespType", "RESULT");
+    }
+
+    void placeOrder(const OrderRequest& request) {
+        const Market& market = markets[request.strategy];
+        query.reset().add("symbol", market.symbol);
+        addLimitOrder(market, request);
+        uint32_t strategy = request.strategy;
+        uint64_t orderId = request.orderId;
+        http.submit(HttpMethod::Post, "/api/v3/order", [this, strategy, orderId](const HttpResponse& response) {
+            if (statusUnknown(response)) {
+                queryOrder(strategy, orderId, OrderAction::New);
+                return;
+            }
+            handleOrderResponse(strategy, orderId, OrderAction::New, response);
+        }, signQuery());
+    }
+
+    void cancelOrder(const OrderRequest& request) {
+        const Market& market = markets[request.strategy];
+        query.reset("/api/v3/order?")
+            .add("symbol", market.symbol)
+            .add("origClientOrderId", OrderIdGenerator::encode(request.orderId).c_str());
+        uint32_t strategy = request.strategy;
+        uint64_t orderId = request.orderId;
+        http.submit(HttpMethod::Delete, signQuery(), [this, strategy, orderId](const HttpResponse& response) {
+            // -2011：訂單已不在掛單中，可能已成交，查詢實際狀態
+            if (statusUnknown(response)
+                || errorCode(nlohmann::json::parse(response.body, nullptr, false)) == CANCEL_REJECTED) {
+                queryOrder(strategy, orderId, OrderAction::Cancel);
+                return;
+            }
+            handleOrderResponse(strategy, orderId, OrderAction::Cancel, response);
+        });
+    }
+
+    // 撤單後以新價格、數量重下（cancelReplace，撤單失敗則不下新單）
+    void replaceOrder(const OrderRequest& request) {
+        const Market& market = markets[request.strategy];
+        query.reset()
+            .add("symbol", market.symbol)
+            .add("cancelReplaceMode", "STOP_ON_FAILURE")
+            .add("cancelOrigClientOrderId", OrderIdGenerator::encode(request.originalOrderId).c_str());
+        addLimitOrder(market, request);
+        uint32_t strategy = request.strategy;
+        uint64_t orderId = request.orderId;
+        uint64_t originalOrderId = request.originalOrderId;
+        http.submit(HttpMethod::Post, "/api/v3/order/cancelReplace",
+                    [this, strategy, orderId, originalOrderId](const HttpResponse& response) {
+            if (statusUnknown(response)) {
+                queryOrder(strategy, originalOrderId, OrderAction::Amend);
+                queryOrder(strategy, orderId, OrderAction::Amend);
+                return;
+            }
+            nlohmann::json body = nlohmann::json::parse(response.body, nullptr, false);
+            if (!response.ok() || !body.is_object()
+                || !body.contains("cancelResponse") || !body.contains("newOrderResponse")) {
+                rejectWithError(orderId, OrderAction::Amend, response, body);
+                return;
+            }
+            reportStatus(strategy, originalOrderId, OrderAction::Amend, body["cancelResponse"]);
+            reportStatus(strategy, orderId, OrderAction::Amend, body["newOrderResponse"]);
+        }, signQuery());
+    }
+
+    // 下單、撤單與查詢的回應都是訂單物件，按其狀態回報；錯誤回應回報拒絕
+    void handleOrderResponse(uint32_t strategy, uint64_t orderId, OrderAction action, const HttpResponse& response) {
+        nlohmann::json body = nlohmann::json::parse(response.body, nullptr, false);
+        if (!response.ok() || !body.is_object()) {
+            rejectWithError(orderId, action, response, body);
+            return;
+        }
+        reportStatus(strategy, orderId, action, body);
+    }
+
+    /**
+     * @brief 按訂單狀態回報
+     *
+     * 任何狀態下只要 executedQty 大於0，都以累計成交數量與 cummulativeQuoteQty 回報成交：
+     * 完全成交回報 Filled；其餘狀態（部分成交後仍掛單、部分成交後撤銷或過期）先回報 PartiallyFilled，
+     * 再回報訂單狀態，撤單前已成交的部分因此不會遺漏。
+     */
+    void reportStatus(uint32_t strategy, uint64_t orderId, OrderAction action, const nlohmann::json& order) {
+        const DecimalScale& scale = markets[strategy].scale;
+        std::string status;
+        OrderReply fill;
+        try {
+            status = order.value("status", "");
+            fill = OrderReply::make(
+                orderId, status == "FILLED" ? OrderReplyType::Filled : OrderReplyType::PartiallyFilled, action);
+            double quoteQuantity = std::stod(order.value("cummulativeQuoteQty", "0"));
+            fill.quantity = scale.toQuantity(std::stod(order.value("executedQty", "0")));
+            fill.amount = quoteQuantity > 0
+                ? scale.toNotional(quoteQuantity)
+                : scale.toPrice(std::stod(order.value("price", "0"))) * fill.quantity;
+            fill.price = averagePrice(fill.amount, fill.quantity);
+        } catch (const std::exception&) {
+            // 欄位型別錯誤、無法解析或超出定點數範圍
+            reply(OrderReply::make(orderId, OrderReplyType::Rejected, action, 0, "Malformed order response"));
+            return;
+        }
+        
+        if (status == "FILLED") {
+            reply(fill);
+            return;
+        }
+        if (fill.quantity > Quantity()) {
+            reply(fill);
+        }
+        
+        if (status == "NEW" || status == "PARTIALLY_FILLED" || status == "PENDING_NEW") {
+            reply(OrderReply::make(orderId, OrderReplyType::Accepted, action));
+        } else if (status == "CANCELED" || status == "PENDING_CANCEL"
+                   || status == "EXPIRED" || status == "EXPIRED_IN_MATCH") {
+            reply(OrderReply::make(orderId, OrderReplyType::Canceled, action));
+        } else {
+            std::string reason = "Order status " + (status.empty() ? std::string("missing") : status);
+            reply(OrderReply::make(orderId, OrderReplyType::Rejected, action, 0, reason.c_str()));
+        }
+    }
+
+    // 交易所錯誤回應 {"code": ..., "msg": ...}；timestamp 超出窗口時立即安排重新校時
+    void rejectWithError(uint64_t orderId, OrderAction action, const HttpResponse& response,
+                         const nlohmann::json& body) {
+        int code = errorCode(body);
+        std::string message = response.errorMessage();
+        if (body.is_object() && body.contains("msg") && body["msg"].is_string()) {
+            message = body["msg"].get<std::string>();
+        }
+        if (code == TIMESTAMP_OUTSIDE_RECV_WINDOW) {
+            nextClockSyncMs = 0;
+        }
+        reply(OrderReply::make(orderId, OrderReplyType::Rejected, action, code, message.c_str()));
+    }
+
+    // 以往返時間的中點估計伺服器時鐘與本地時鐘的差
+    void requestClockSync() {
+        clockSyncPending = true;
+        long long sentAt = nowMs();
+        http.submit(HttpMethod::Get, "/api/v3/time", [this, sentAt](const HttpResponse& response) {
+            clockSyncPending = false;
+            long long receivedAt = nowMs();
+            nlohmann::json body = nlohmann::json::parse(response.body, nullptr, false);
+            if (!response.ok() || !body.is_object() || !body.contains("serverTime")
+                || !body["serverTime"].is_number_integer()) {
+                std::cerr << "Exchange clock sync failed: " << response.errorMessage() << std::endl;
+                nextClockSyncMs = receivedAt + CLOCK_RETRY_MS;
+                return;
+            }
+            clockOffsetMs = body["serverTime"].get<long long>() - (sentAt + receivedAt) / 2;
+            nextClockSyncMs = receivedAt + CLOCK_SYNC_INTERVAL_MS;
+            clockSynced = true;
+        });
+    }
+};
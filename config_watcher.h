@@ -0,0 +1,155 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "strategy_config.h"
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief 監視配置文件並以不可變快照發布新配置
+ *
+ * 背景執行緒以 inotify 監視配置文件所在目錄（非 Linux 平台改為每秒檢查修改時間），
+ * 文件變更後重新解析並校驗，成功則建立新快照並以原子指標交換發布；
+ * 交易迴圈每次行情只做一次 acquire 讀取，無需加鎖。
+ * 舊快照在監視器存續期間不釋放，讀取端持有的指標始終有效
+ * （配置只在人工修改時變更，保留的快照數量很小）。
+ * 需要重啟才能生效的鍵（見 EngineConfig::restartRequiredKey）變更時拒絕重載。
+ */
+class ConfigWatcher {
+private:
+    std::string path;
+    std::atomic<const EngineConfig*> current;
+    std::vector<std::unique_ptr<const EngineConfig>> snapshots;  // 只由監視執行緒修改
+    std::string lastContent;
+    std::atomic<bool> running;
+    std::thread watcher;
+
+public:
+    /**
+     * @param configPath 配置文件路徑
+     * @param initial 啟動時載入的配置
+     */
+    ConfigWatcher(const std::string& configPath, const EngineConfig& initial)
+        : path(configPath)
+        , current(nullptr)
+        , lastContent(readFile(configPath))
+        , running(false) {
+        snapshots.push_back(std::make_unique<const EngineConfig>(initial));
+        current.store(snapshots.back().get(), std::memory_order_release);
+    }
+
+    ~ConfigWatcher() {
+        stop();
+    }
+
+    ConfigWatcher(const ConfigWatcher&) = delete;
+    ConfigWatcher& operator=(const ConfigWatcher&) = delete;
+
+    // 最新的配置快照，在監視器存續期間有效
+    const EngineConfig* snapshot() const {
+        return current.load(std::memory_order_acquire);
+    }
+
+    void start() {
+        if (running.exchange(true)) return;
+        watcher = std::thread([this]() { watch(); });
+    }
+
+    void stop() {
+        running = false;
+        if (watcher.joinable()) {
+            watcher.join();
+        }
+    }
+
+private:
+    static std::string readFile(const std::string& filePath) {
+        std::ifstream file(filePath);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    void watch() {
+#ifdef __linux__
+        std::filesystem::path configPath(path);
+        std::string directory = configPath.has_parent_path() ? configPath.parent_path().string() : ".";
+        std::string fileName = configPath.filename().string();
+
+        int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        // 監視目錄而非文件本身：編輯器常以寫入臨時文件再改名的方式保存
+        if (fd >= 0 && inotify_add_watch(fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE) >= 0) {
+            // 建構之後、開始監視之前的修改不會產生事件，先比對一次內容
+            reload();
+            alignas(inotify_event) char buffer[4096];
+            while (running) {
+                pollfd descriptor{fd, POLLIN, 0};
+                if (poll(&descriptor, 1, 500) <= 0) continue;
+
+                bool changed = false;
+                ssize_t length;
+                while ((length = read(fd, buffer, sizeof(buffer))) > 0) {
+                    for (char* cursor = buffer; cursor < buffer + length;) {
+                        auto* event = reinterpret_cast<inotify_event*>(cursor);
+                        if (event->len > 0 && fileName == event->name) {
+                            changed = true;
+                        }
+                        cursor += sizeof(inotify_event) + event->len;
+                    }
+                }
+                if (changed) {
+                    reload();
+                }
+            }
+            close(fd);
+            return;
+        }
+        if (fd >= 0) close(fd);
+        std::cerr << "inotify unavailable, polling " << path << " for changes" << std::endl;
+#endif
+        std::error_code error;
+        auto lastWrite = std::filesystem::last_write_time(path, error);
+        reload();
+        while (running) {
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+            auto writeTime = std::filesystem::last_write_time(path, error);
+            if (!error && writeTime != lastWrite) {
+                lastWrite = writeTime;
+                reload();
+            }
+        }
+    }
+
+    // 解析、校驗並發布新快照；失敗時保留現有配置
+    void reload() {
+        std::string content = readFile(path);
+        if (content.empty() || content == lastContent) return;
+        lastContent = content;
+
+        try {
+            EngineConfig next = EngineConfig::fromJson(nlohmann::json::parse(content));
+            const char* restartKey = snapshot()->restartRequiredKey(next);
+            if (restartKey != nullptr) {
+                std::cerr << "Config reload rejected: changing " << restartKey
+                          << " requires a restart" << std::endl;
+                return;
+            }
+            snapshots.push_back(std::make_unique<const EngineConfig>(std::move(next)));
+            current.store(snapshots.back().get(), std::memory_order_release);
+        } catch (const std::exception& error) {
+            std::cerr << "Config reload rejected: " << error.what() << std::endl;
+        }
+    }
+};
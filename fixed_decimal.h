@@ -0,0 +1,156 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+/**
+ * @brief 定點小數：以 int64 保存最小單位數（價格的 tick、數量的 step）
+ *
+ * 加減與比較都是整數運算，沒有浮點誤差；小數位數不在值裡，
+ * 由每個交易對的 DecimalScale 決定，只在與 double 或字串互轉時用到。
+ * Tag 區分價格、數量與金額，避免不同單位的值混用。
+ */
+template <typename Tag>
+class FixedDecimal {
+private:
+    int64_t units;
+
+    explicit constexpr FixedDecimal(int64_t value) : units(value) {}
+
+public:
+    constexpr FixedDecimal() : units(0) {}
+
+    static constexpr FixedDecimal fromUnits(int64_t value) { return FixedDecimal(value); }
+    constexpr int64_t raw() const { return units; }
+
+    constexpr FixedDecimal operator+(FixedDecimal other) const { return FixedDecimal(units + other.units); }
+    constexpr FixedDecimal operator-(FixedDecimal other) const { return FixedDecimal(units - other.units); }
+    constexpr FixedDecimal operator-() const { return FixedDecimal(-units); }
+    constexpr FixedDecimal operator*(int64_t count) const { return FixedDecimal(units * count); }
+    FixedDecimal& operator+=(FixedDecimal other) { units += other.units; return *this; }
+    FixedDecimal& operator-=(FixedDecimal other) { units -= other.units; return *this; }
+
+    constexpr bool operator==(FixedDecimal other) const { return units == other.units; }
+    constexpr bool operator!=(FixedDecimal other) const { return units != other.units; }
+    constexpr bool operator<(FixedDecimal other) const { return units < other.units; }
+    constexpr bool operator<=(FixedDecimal other) const { return units <= other.units; }
+    constexpr bool operator>(FixedDecimal other) const { return units > other.units; }
+    constexpr bool operator>=(FixedDecimal other) const { return units >= other.units; }
+};
+
+struct PriceTag {};
+struct QuantityTag {};
+struct NotionalTag {};
+
+using Price = FixedDecimal<PriceTag>;        // 單位：10^-price_decimal_places
+using Quantity = FixedDecimal<QuantityTag>;  // 單位：10^-quantity_decimal_places
+using Notional = FixedDecimal<NotionalTag>;  // 價格 × 數量，單位：10^-(兩者小數位數之和)
+
+/**
+ * @brief 價格 × 數量 = 金額，整數相乘即精確結果
+ * @throws std::runtime_error 乘積超出 int64 範圍
+ */
+inline Notional operator*(Price price, Quantity quantity) {
+    int64_t units;
+    if (__builtin_mul_overflow(price.raw(), quantity.raw(), &units)) {
+        throw std::runtime_error("Notional out of range: " + std::to_string(price.raw()) + " x "
+                                 + std::to_string(quantity.raw()) + " units");
+    }
+    return Notional::fromUnits(units);
+}
+
+inline Notional operator*(Quantity quantity, Price price) {
+    return price * quantity;
+}
+
+/**
+ * @brief 金額 ÷ 數量 = 價格（四捨五入到價格最小單位），數量為0時回傳0
+ */
+inline Price averagePrice(Notional amount, Quantity quantity) {
+    if (quantity.raw() == 0) return Price();
+    int64_t divisor = quantity.raw() < 0 ? -quantity.raw() : quantity.raw();
+    int64_t dividend = quantity.raw() < 0 ? -amount.raw() : amount.raw();
+    int64_t half = dividend < 0 ? -divisor / 2 : divisor / 2;
+    return Price::fromUnits((dividend + half) / divisor);
+}
+
+/**
+ * @brief 單一交易對的小數位數，負責定點數與 double、字串之間的轉換
+ *
+ * 金額的小數位數為價格與數量之和，上限 MAX_TOTAL_DECIMALS（10）時金額仍可表示到約 9.2 億；
+ * 超出 int64 範圍的轉換拋出例外，不會溢位成錯誤的值。
+ */
+class DecimalScale {
+public:
+    static constexpr int MAX_TOTAL_DECIMALS = 10;
+
+private:
+    int priceDecimals;
+    int quantityDecimals;
+    int64_t priceFactor;
+    int64_t quantityFactor;
+    int64_t notionalFactor;
+
+    static int64_t pow10(int exponent) {
+        int64_t factor = 1;
+        for (int i = 0; i < exponent; i++) factor *= 10;
+        return factor;
+    }
+
+    // 超出 int64 範圍（含 NaN 與無窮大）時 llround 的結果未定義，先檢查再轉換
+    static int64_t toUnits(double value, int64_t factor) {
+        double scaled = value * static_cast<double>(factor);
+        if (!(std::fabs(scaled) < 9223372036854775808.0)) {
+            throw std::runtime_error("Decimal value out of range: " + std::to_string(value));
+        }
+        return static_cast<int64_t>(std::llround(scaled));
+    }
+
+    static std::string formatUnits(int64_t units, int decimals, int64_t factor) {
+        uint64_t magnitude = units < 0 ? 0 - static_cast<uint64_t>(units) : static_cast<uint64_t>(units);
+        std::string text = std::to_string(magnitude / static_cast<uint64_t>(factor));
+        if (decimals > 0) {
+            std::string fraction = std::to_string(magnitude % static_cast<uint64_t>(factor));
+            text += '.';
+            text.append(decimals - fraction.size(), '0');
+            text += fraction;
+        }
+        return units < 0 ? "-" + text : text;
+    }
+
+public:
+    /**
+     * @param pricePlaces 價格小數位數（對應交易所 PRICE_FILTER 的 tickSize）
+     * @param quantityPlaces 數量小數位數（對應交易所 LOT_SIZE 的 stepSize）
+     */
+    DecimalScale(int pricePlaces, int quantityPlaces)
+        : priceDecimals(pricePlaces)
+        , quantityDecimals(quantityPlaces) {
+        // 金額的小數位數為兩者之和，需在 int64 範圍內留足整數位
+        if (pricePlaces < 0 || quantityPlaces < 0 || pricePlaces + quantityPlaces > MAX_TOTAL_DECIMALS) {
+            throw std::runtime_error("Unsupported decimal places: price " + std::to_string(pricePlaces)
+                                     + ", quantity " + std::to_string(quantityPlaces));
+        }
+        priceFactor = pow10(pricePlaces);
+        quantityFactor = pow10(quantityPlaces);
+        notionalFactor = pow10(pricePlaces + quantityPlaces);
+    }
+
+    int getPriceDecimals() const { return priceDecimals; }
+    int getQuantityDecimals() const { return quantityDecimals; }
+
+    // 轉為最小單位（四捨五入），超出 int64 範圍時拋出 std::runtime_error
+    Price toPrice(double value) const { return Price::fromUnits(toUnits(value, priceFactor)); }
+    Quantity toQuantity(double value) const { return Quantity::fromUnits(toUnits(value, quantityFactor)); }
+    Notional toNotional(double value) const { return Notional::fromUnits(toUnits(value, notionalFactor)); }
+
+    double toDouble(Price value) const { return static_cast<double>(value.raw()) / static_cast<double>(priceFactor); }
+    double toDouble(Quantity value) const { return static_cast<double>(value.raw()) / static_cast<double>(quantityFactor); }
+    double toDouble(Notional value) const { return static_cast<double>(value.raw()) / static_cast<double>(notionalFactor); }
+
+    std::string format(Price value) const { return formatUnits(value.raw(), priceDecimals, priceFactor); }
+    std::string format(Quantity value) const { return formatUnits(value.raw(), quantityDecimals, quantityFactor); }
+    std::string format(Notional value) const { return formatUnits(value.raw(), priceDecimals + quantityDecimals, notionalFactor); }
+};
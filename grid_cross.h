@@ -0,0 +1,80 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "grid_geometry.h"
+
+/**
+ * @brief 一次網格穿越：在第 levelIndex 條網格線買入或賣出
+ */
+struct GridCross {
+    bool isBuy;
+    long long levelIndex;
+};
+
+/**
+ * @brief 以前後兩次價格計算被穿越的網格線
+ *
+ * 網格線位於整數網格座標上（見 GridGeometry）。價格進入某條網格線的觸發區
+ * （座標距離不超過 order_trigger_threshold）即視為觸及：
+ *   下跌時觸及下方網格線 → 買入，上漲時觸及上方網格線 → 賣出。
+ * 兩次價格之間跨過多條網格線時，以座標直接算出索引範圍，
+ * 一次產生全部穿越，不逐條掃描網格。前後兩次價格都以當前幾何換算，
+ * 網格間距改變時不會誤判穿越。
+ */
+class GridCrossDetector {
+private:
+    double lastBuyPrice;
+    double lastSellPrice;
+    bool hasLast;
+
+public:
+    GridCrossDetector() : lastBuyPrice(0), lastSellPrice(0), hasLast(false) {}
+
+    /**
+     * @param buyPrice 判斷買入用的價格（最新價或賣一價）
+     * @param sellPrice 判斷賣出用的價格（最新價或買一價）
+     * @param geometry 網格幾何
+     * @param threshold 觸發區佔相鄰網格線距離的比例
+     * @param minIndex 可交易的最低網格線索引
+     * @param maxIndex 可交易的最高網格線索引
+     * @param crosses 輸出：本次穿越的網格線（先清空）
+     */
+    void detect(double buyPrice, double sellPrice, const GridGeometry& geometry, double threshold,
+                long long minIndex, long long maxIndex, std::vector<GridCross>& crosses) {
+        crosses.clear();
+        if (!hasLast) {
+            lastBuyPrice = buyPrice;
+            lastSellPrice = sellPrice;
+            hasLast = true;
+            return;
+        }
+
+        // 買入：上次價格仍在觸發區之上、本次進入觸發區，即座標 k ∈ [buy - threshold, lastBuy - threshold)
+        if (buyPrice < lastBuyPrice) {
+            long long first = static_cast<long long>(std::ceil(geometry.coordinate(buyPrice) - threshold));
+            long long last = static_cast<long long>(std::ceil(geometry.coordinate(lastBuyPrice) - threshold)) - 1;
+            first = std::max(first, minIndex);
+            last = std::min(last, maxIndex);
+            // 由高到低，先成交最先被觸及的網格線
+            for (long long k = last; k >= first; k--) {
+                crosses.push_back(GridCross{true, k});
+            }
+        }
+
+        // 賣出：k ∈ (lastSell + threshold, sell + threshold]
+        if (sellPrice > lastSellPrice) {
+            long long first = static_cast<long long>(std::floor(geometry.coordinate(lastSellPrice) + threshold)) + 1;
+            long long last = static_cast<long long>(std::floor(geometry.coordinate(sellPrice) + threshold));
+            first = std::max(first, minIndex);
+            last = std::min(last, maxIndex);
+            for (long long k = first; k <= last; k++) {
+                crosses.push_back(GridCross{false, k});
+            }
+        }
+
+        lastBuyPrice = buyPrice;
+        lastSellPrice = sellPrice;
+    }
+};
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+/**
+ * @brief 網格幾何：價格與網格線索引之間的O(1)換算
+ *
+ * 將價格映射到連續的網格座標，整數座標即為網格線：
+ *   等差（arithmetic）：座標 = 價格 / 間距，網格線價格 = k × 間距
+ *   等比（geometric）：座標 = ln(價格) / ln(1 + 比例)，網格線價格 = (1 + 比例)^k
+ * 觸發區等以座標表示的距離在兩種模式下可以共用同一套計算。
+ * 有限網格（infinite_grid 為 false）只允許 [lower_price_limit, upper_price_limit] 內的網格線。
+ */
+class GridGeometry {
+public:
+    enum class Mode { Arithmetic, Geometric };
+
+private:
+    Mode mode;
+    double spacing;  // 等差為價格間距，等比為相鄰網格線的價格比例
+    double logStep;  // 等比模式的 ln(1 + 比例)
+    bool bounded;
+    double lowerLimit;
+    double upperLimit;
+    long long lowerIndex;
+    long long upperIndex;
+
+    void updateBounds() {
+        if (!bounded) return;
+        // 容許浮點誤差，恰好落在價格上下限的網格線仍然有效
+        lowerIndex = static_cast<long long>(std::ceil(coordinate(lowerLimit) - 1e-9));
+        upperIndex = static_cast<long long>(std::floor(coordinate(upperLimit) + 1e-9));
+    }
+
+public:
+    /**
+     * @param gridMode 等差或等比
+     * @param gridSpacing 等差為價格間距，等比為價格比例（例如：0.005 表示 0.5%）
+     * @param limited 是否限制在價格上下限之內
+     * @param lower 價格下限
+     * @param upper 價格上限
+     */
+    GridGeometry(Mode gridMode, double gridSpacing, bool limited, double lower, double upper)
+        : mode(gridMode)
+        , spacing(0)
+        , logStep(0)
+        , bounded(limited)
+        , lowerLimit(lower)
+        , upperLimit(upper)
+        , lowerIndex(0)
+        , upperIndex(-1) {
+        if (bounded && (lower <= 0 || upper < lower)) {
+            throw std::runtime_error("Invalid grid price limits");
+        }
+        setSpacing(gridSpacing);
+    }
+
+    void setSpacing(double gridSpacing) {
+        if (!(gridSpacing > 0)) {
+            throw std::runtime_error("Grid spacing must be positive");
+        }
+        spacing = gridSpacing;
+        logStep = std::log1p(gridSpacing);
+        updateBounds();
+    }
+
+    // 更新價格上下限（limited 為 false 時不限制）
+    void setBounds(bool limited, double lower, double upper) {
+        if (limited && (lower <= 0 || upper < lower)) {
+            throw std::runtime_error("Invalid grid price limits");
+        }
+        bounded = limited;
+        lowerLimit = lower;
+        upperLimit = upper;
+        updateBounds();
+    }
+
+    Mode getMode() const { return mode; }
+    double getSpacing() const { return spacing; }
+
+    // 價格對應的連續網格座標
+    double coordinate(double price) const {
+        if (mode == Mode::Arithmetic) return price / spacing;
+        return std::log(price) / logStep;
+    }
+
+    // 網格座標對應的價格
+    double priceAt(double levelCoordinate) const {
+        if (mode == Mode::Arithmetic) return levelCoordinate * spacing;
+        return std::exp(levelCoordinate * logStep);
+    }
+
+    /**
+     * @brief 價格附近相鄰網格線至少相差一個最小價格單位所需的間距
+     * @param tick 最小價格單位
+     * @param price 參考價格，等比網格以價格下限或當前價格計算
+     */
+    double minimumSpacing(double tick, double price) const {
+        if (mode == Mode::Arithmetic) return tick;
+        return tick / price;
+    }
+
+    // 最接近價格的網格線
+    long long indexOf(double price) const { return std::llround(coordinate(price)); }
+
+    double levelPrice(long long levelIndex) const { return priceAt(static_cast<double>(levelIndex)); }
+
+    bool isBounded() const { return bounded; }
+    long long minLevel() const { return lowerIndex; }
+    long long maxLevel() const { return upperIndex; }
+
+    static Mode parseMode(const std::string& name) {
+        if (name == "arithmetic") return Mode::Arithmetic;
+        if (name == "geometric") return Mode::Geometric;
+        throw std::runtime_error("Unknown grid spacing mode: " + name);
+    }
+};
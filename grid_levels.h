@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 以整數網格索引存取的環形陣列
+ *
+ * 覆蓋連續的索引窗口 [firstIndex, firstIndex + capacity)，
+ * 索引 k 固定存放在 k mod capacity 號槽位，按索引存取為O(1)，
+ * 所有槽位在一塊連續記憶體中，不需要樹狀查找。
+ */
+template <typename T>
+class GridLevelRing {
+private:
+    struct Slot {
+        long long index;
+        bool used;
+        T value;
+    };
+
+    std::vector<Slot> slots;
+    long long first;
+
+    size_t slotOf(long long index) const {
+        long long capacity = static_cast<long long>(slots.size());
+        long long slot = index % capacity;
+        return static_cast<size_t>(slot < 0 ? slot + capacity : slot);
+    }
+
+public:
+    explicit GridLevelRing(size_t capacity)
+        : slots(capacity, Slot{0, false, T()})
+        , first(0) {
+        if (capacity == 0) {
+            throw std::runtime_error("Grid level ring capacity must be positive");
+        }
+    }
+
+    size_t capacity() const { return slots.size(); }
+    long long firstIndex() const { return first; }
+    long long lastIndex() const { return first + static_cast<long long>(slots.size()) - 1; }
+
+    bool contains(long long index) const {
+        return index >= first && index <= lastIndex();
+    }
+
+    // 查找已使用的槽位，不存在時回傳 nullptr
+    T* find(long long index) {
+        if (!contains(index)) return nullptr;
+        Slot& slot = slots[slotOf(index)];
+        return slot.used && slot.index == index ? &slot.value : nullptr;
+    }
+
+    const T* find(long long index) const {
+        if (!contains(index)) return nullptr;
+        const Slot& slot = slots[slotOf(index)];
+        return slot.used && slot.index == index ? &slot.value : nullptr;
+    }
+
+    // 取得索引對應的槽位，未使用時初始化；索引必須位於窗口內
+    T& get(long long index) {
+        if (!contains(index)) {
+            throw std::out_of_range("Grid level " + std::to_string(index) + " outside window");
+        }
+        Slot& slot = slots[slotOf(index)];
+        if (!slot.used || slot.index != index) {
+            slot.index = index;
+            slot.used = true;
+            slot.value = T();
+        }
+        return slot.value;
+    }
+
+    /**
+     * @brief 移動窗口起點，移出窗口的槽位先交給 onEvict(index, value) 處理再清空
+     *
+     * 窗口平移 k 格時只處理移出一側的 k 個槽位，移入的 k 個索引
+     * 正好落在這些被騰出的槽位上；起點不變時不做任何事。
+     */
+    template <typename EvictHandler>
+    void setWindow(long long newFirst, EvictHandler&& onEvict) {
+        if (newFirst == first) return;
+
+        long long capacity = static_cast<long long>(slots.size());
+        long long shift = newFirst - first;
+        if (shift >= capacity || -shift >= capacity) {
+            clear(onEvict);
+            first = newFirst;
+            return;
+        }
+
+        // 上移時移出 [first, newFirst)，下移時移出 (newLast, lastIndex]
+        long long evictFrom = shift > 0 ? first : newFirst + capacity;
+        long long evictTo = shift > 0 ? newFirst : first + capacity;
+        for (long long index = evictFrom; index < evictTo; index++) {
+            Slot& slot = slots[slotOf(index)];
+            if (slot.used && slot.index == index) {
+                onEvict(slot.index, slot.value);
+                slot.used = false;
+                slot.value = T();
+            }
+        }
+        first = newFirst;
+    }
+
+    /**
+     * @brief 改變容量並把窗口起點移到 newFirst
+     *
+     * 仍在新窗口內的槽位原樣搬入新陣列，其餘交給 onEvict 處理；
+     * 只在網格數量改變時使用，代價為一次O(容量)。
+     */
+    template <typename EvictHandler>
+    void resize(size_t newCapacity, long long newFirst, EvictHandler&& onEvict) {
+        if (newCapacity == 0) {
+            throw std::runtime_error("Grid level ring capacity must be positive");
+        }
+        std::vector<Slot> previous(newCapacity, Slot{0, false, T()});
+        previous.swap(slots);
+        first = newFirst;
+        for (Slot& slot : previous) {
+            if (!slot.used) continue;
+            if (contains(slot.index)) {
+                slots[slotOf(slot.index)] = std::move(slot);
+            } else {
+                onEvict(slot.index, slot.value);
+            }
+        }
+    }
+
+    // 清空所有槽位，每個已使用槽位先交給 onEvict 處理
+    template <typename EvictHandler>
+    void clear(EvictHandler&& onEvict) {
+        for (Slot& slot : slots) {
+            if (slot.used) {
+                onEvict(slot.index, slot.value);
+                slot.used = false;
+                slot.value = T();
+            }
+        }
+    }
+};
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <openssl/core_names.h>
+#include <openssl/evp.h>
+#include <openssl/params.h>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+/**
+ * @brief 以固定密鑰計算 HMAC-SHA256 並輸出十六進位簽名
+ *
+ * 密鑰只在建構時設定一次：OpenSSL 在此時算好內外層填充的摘要狀態並保存在上下文中。
+ * 每次簽名以空密鑰重新初始化同一個上下文，直接複製保存的預設狀態，
+ * 不再重新雜湊密鑰，也不分配記憶體。非執行緒安全，每個簽名執行緒各自持有一個實例。
+ */
+class HmacSha256Signer {
+private:
+    static constexpr size_t DIGEST_LENGTH = 32;
+
+    EVP_MAC* mac;
+    EVP_MAC_CTX* context;  // 已設定密鑰的上下文
+
+public:
+    static constexpr size_t HEX_LENGTH = 2 * DIGEST_LENGTH;
+
+    /**
+     * @param secret 簽名密鑰（例如交易所的 API secret）
+     */
+    explicit HmacSha256Signer(const std::string& secret)
+        : mac(EVP_MAC_fetch(nullptr, "HMAC", nullptr))
+        , context(nullptr) {
+        if (mac == nullptr) {
+            throw std::runtime_error("HMAC is not available in OpenSSL");
+        }
+        context = EVP_MAC_CTX_new(mac);
+        char digest[] = "SHA256";
+        OSSL_PARAM params[] = {
+            OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, digest, 0),
+            OSSL_PARAM_construct_end()};
+        if (context == nullptr || secret.empty()
+            || EVP_MAC_init(context, reinterpret_cast<const unsigned char*>(secret.data()), secret.size(), params) != 1) {
+            EVP_MAC_CTX_free(context);
+            EVP_MAC_free(mac);
+            throw std::runtime_error("Failed to initialize HMAC-SHA256 signer");
+        }
+    }
+
+    ~HmacSha256Signer() {
+        EVP_MAC_CTX_free(context);
+        EVP_MAC_free(mac);
+    }
+
+    HmacSha256Signer(const HmacSha256Signer&) = delete;
+    HmacSha256Signer& operator=(const HmacSha256Signer&) = delete;
+
+    /**
+     * @brief 對 data 簽名，寫入 HEX_LENGTH 個小寫十六進位字元（不含結尾的 '\0'）
+     * @throws std::runtime_error OpenSSL 計算失敗
+     */
+    void sign(const char* data, size_t length, char* hexOut) {
+        static constexpr char HEX[] = "0123456789abcdef";
+        unsigned char digest[DIGEST_LENGTH];
+        size_t digestLength = 0;
+        if (EVP_MAC_init(context, nullptr, 0, nullptr) != 1
+            || EVP_MAC_update(context, reinterpret_cast<const unsigned char*>(data), length) != 1
+            || EVP_MAC_final(context, digest, &digestLength, sizeof(digest)) != 1
+            || digestLength != DIGEST_LENGTH) {
+            throw std::runtime_error("HMAC-SHA256 signing failed");
+        }
+        for (size_t i = 0; i < DIGEST_LENGTH; i++) {
+            hexOut[2 * i] = HEX[digest[i] >> 4];
+            hexOut[2 * i + 1] = HEX[digest[i] & 0x0f];
+        }
+    }
+};
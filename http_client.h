@@ -0,0 +1,106 @@
+#pragma once
+
+#include <curl/curl.h>
+#include <string>
+#include <stdexcept>
+
+/**
+ * @brief 長連線HTTP客戶端
+ *
+ * 持有單一可重用的cURL句柄，讓連續請求共用同一條TCP/TLS連線，
+ * 並快取DNS解析結果，避免每次輪詢都重新握手。
+ * 非執行緒安全：每個執行緒應持有自己的實例。
+ */
+class HttpClient {
+private:
+    CURL* curl;
+    std::string baseUrl;
+    std::string url;             // 重用的URL緩衝區
+    std::string responseBuffer;  // 重用的回應緩衝區
+    long lastStatus;
+
+    static size_t writeCallback(void* contents, size_t size, size_t nmemb, std::string* output) {
+        size_t totalSize = size * nmemb;
+        output->append(static_cast<char*>(contents), totalSize);
+        return totalSize;
+    }
+
+public:
+    /**
+     * @param base 服務端根地址（例如："https://api.binance.com"）
+     * @param bufferReserve 回應緩衝區預留大小
+     */
+    explicit HttpClient(const std::string& base, size_t bufferReserve = 4096)
+        : curl(curl_easy_init())
+        , baseUrl(base)
+        , lastStatus(0) {
+        if (!curl) {
+            throw std::runtime_error("cURL init failed");
+        }
+        url.reserve(baseUrl.size() + 256);
+        responseBuffer.reserve(bufferReserve);
+
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writeCallback);
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &responseBuffer);
+        curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+        // 保持連線並優先使用HTTP/2（伺服器不支援時自動退回HTTP/1.1）
+        curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, (long)CURL_HTTP_VERSION_2TLS);
+        curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+        curl_easy_setopt(curl, CURLOPT_TCP_KEEPIDLE, 30L);
+        curl_easy_setopt(curl, CURLOPT_TCP_KEEPINTVL, 15L);
+        curl_easy_setopt(curl, CURLOPT_TCP_NODELAY, 1L);
+        curl_easy_setopt(curl, CURLOPT_DNS_CACHE_TIMEOUT, 3600L);
+        curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS, 5000L);
+        curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, 10000L);
+    }
+
+    ~HttpClient() {
+        if (curl) {
+            curl_easy_cleanup(curl);
+        }
+    }
+
+    HttpClient(const HttpClient&) = delete;
+    HttpClient& operator=(const HttpClient&) = delete;
+
+    /**
+     * @brief 發送GET請求
+     * @param pathAndQuery 路徑與查詢字串（例如："/api/v3/ticker/price?symbol=ETHUSDT"）
+     * @return 回應內容，指向內部緩衝區，下次請求前有效
+     */
+    const std::string& get(const std::string& pathAndQuery) {
+        url.assign(baseUrl).append(pathAndQuery);
+        responseBuffer.clear();
+
+        curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+        curl_easy_setopt(curl, CURLOPT_HTTPGET, 1L);
+        CURLcode res = curl_easy_perform(curl);
+        if (res != CURLE_OK) {
+            std::string message = "cURL Error: " + std::to_string(res) + " (" + curl_easy_strerror(res) + ")";
+            throw std::runtime_error(message);
+        }
+
+        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &lastStatus);
+        if (lastStatus >= 400) {
+            throw std::runtime_error("HTTP " + std::to_string(lastStatus) + ": " + responseBuffer);
+        }
+        return responseBuffer;
+    }
+
+    /**
+     * @brief 預熱連線：提前完成DNS解析與TCP/TLS握手
+     * @param pathAndQuery 用於預熱的輕量端點
+     * @return 預熱是否成功
+     */
+    bool warmUp(const std::string& pathAndQuery) {
+        try {
+            get(pathAndQuery);
+            return true;
+        } catch (const std::runtime_error&) {
+            return false;
+        }
+    }
+
+    long lastStatusCode() const { return lastStatus; }
+    const std::string& getBaseUrl() const { return baseUrl; }
+};
@@ -0,0 +1,254 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "async_http_client.h"
+#include "volatility.h"
+
+/**
+ * @brief 啟動時並行回補歷史K線
+ *
+ * 每個交易對的缺失區間按每頁1000根切分，所有交易對的所有分頁同時排隊，
+ * 以 AsyncHttpClient 在單一執行緒上並行請求；依回應中的
+ * X-MBX-USED-WEIGHT-1M 控制速率，收到 429/418 時依 Retry-After 退避重試。
+ * 已收盤的K線快取在磁碟上，重啟時只補抓快取之前（回補根數調大時）與之後缺少的部分。
+ * 某個交易對的請求失敗或回應無法解析時只放棄該交易對，其餘交易對照常完成。
+ */
+class KlineBackfill {
+private:
+    struct Page {
+        std::string symbol;
+        long long startTime;
+        long long endTime;
+    };
+
+    AsyncHttpClient http;
+    std::string interval;
+    long long intervalMs;
+    size_t barCount;
+    std::string cacheDir;
+    size_t maxConcurrency;
+    int weightLimit;
+
+    static constexpr int PAGE_LIMIT = 1000;
+    static constexpr int REQUEST_WEIGHT = 2;
+
+public:
+    /**
+     * @param baseUrl REST根地址
+     * @param klineInterval K線週期（例如："1m"）
+     * @param bars 每個交易對需要的K線根數
+     * @param cacheDirectory 磁碟快取目錄，空字串表示不快取
+     * @param concurrency 同時進行的請求數上限
+     * @param weightPerMinute 每分鐘權重上限（Binance 現貨預設6000）
+     */
+    KlineBackfill(const std::string& baseUrl, const std::string& klineInterval, size_t bars,
+                  const std::string& cacheDirectory, size_t concurrency = 8, int weightPerMinute = 6000)
+        : http(baseUrl, static_cast<long>(concurrency))
+        , interval(klineInterval)
+        , intervalMs(klineIntervalMs(klineInterval))
+        , barCount(bars)
+        , cacheDir(cacheDirectory)
+        , maxConcurrency(std::max<size_t>(1, concurrency))
+        , weightLimit(weightPerMinute) {}
+
+    /**
+     * @brief 回補所有交易對的已收盤K線
+     * @return 交易對 -> 按時間排序的最近 barCount 根K線；回補失敗的交易對不在結果中
+     */
+    std::unordered_map<std::string, std::vector<Kline>> run(const std::vector<std::string>& symbols) {
+        long long now = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        long long currentOpen = now - now % intervalMs;  // 尚未收盤的K線
+        long long windowStart = currentOpen - static_cast<long long>(barCount) * intervalMs;
+
+        std::unordered_map<std::string, std::vector<Kline>> result;
+        std::deque<Page> queue;
+        for (const auto& symbol : symbols) {
+            std::vector<Kline>& bars = result[symbol];
+            bars = loadCache(symbol, windowStart);
+
+            if (bars.empty()) {
+                queuePages(queue, symbol, windowStart, currentOpen);
+            } else {
+                queuePages(queue, symbol, windowStart, bars.front().openTime);
+                queuePages(queue, symbol, bars.back().openTime + intervalMs, currentOpen);
+            }
+        }
+
+        size_t totalPages = queue.size();
+        auto started = std::chrono::steady_clock::now();
+        std::unordered_set<std::string> failed;
+        fetchPages(queue, result, failed);
+
+        for (const std::string& symbol : failed) {
+            result.erase(symbol);
+        }
+        for (auto& [symbol, bars] : result) {
+            normalize(bars, windowStart);
+            saveCache(symbol, bars);
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - started).count();
+        std::cout << "Kline backfill: " << symbols.size() << " symbols, " << totalPages
+                  << " pages fetched in " << elapsed << " ms";
+        if (!failed.empty()) {
+            std::cout << " (" << failed.size() << " failed)";
+        }
+        std::cout << std::endl;
+        return result;
+    }
+
+private:
+    // 把 [from, to) 內的K線按每頁 PAGE_LIMIT 根排入佇列
+    void queuePages(std::deque<Page>& queue, const std::string& symbol, long long from, long long to) const {
+        for (long long start = from; start < to; start += PAGE_LIMIT * intervalMs) {
+            long long end = std::min(start + PAGE_LIMIT * intervalMs, to) - 1;
+            queue.push_back(Page{symbol, start, end});
+        }
+    }
+
+    void fetchPages(std::deque<Page>& queue, std::unordered_map<std::string, std::vector<Kline>>& result,
+                    std::unordered_set<std::string>& failed) {
+        int usedWeight = 0;
+        auto pauseUntil = std::chrono::steady_clock::now();
+        std::string path;
+
+        while (!queue.empty() || http.inFlight() > 0) {
+            bool paused = std::chrono::steady_clock::now() < pauseUntil;
+            // 已用權重逼近上限時暫停提交，等待下一分鐘窗口
+            if (!paused && !queue.empty() && usedWeight + REQUEST_WEIGHT * static_cast<int>(http.inFlight() + 1) > weightLimit * 8 / 10) {
+                pauseUntil = nextMinute();
+                usedWeight = 0;
+                std::cerr << "Kline backfill approaching rate limit, pausing" << std::endl;
+                paused = true;
+            }
+
+            while (!paused && !queue.empty() && http.inFlight() < maxConcurrency) {
+                Page page = queue.front();
+                queue.pop_front();
+                if (failed.count(page.symbol) > 0) continue;  // 該交易對已放棄，略過其餘分頁
+                path = "/api/v3/klines?symbol=" + page.symbol + "&interval=" + interval
+                     + "&startTime=" + std::to_string(page.startTime)
+                     + "&endTime=" + std::to_string(page.endTime)
+                     + "&limit=" + std::to_string(PAGE_LIMIT);
+
+                http.submit(HttpMethod::Get, path, [&, page](const HttpResponse& response) {
+                    if (response.usedWeight >= 0) {
+                        usedWeight = response.usedWeight;
+                    }
+                    if (response.status == 429 || response.status == 418) {
+                        int waitSeconds = std::max(1, response.retryAfterSeconds);
+                        pauseUntil = std::chrono::steady_clock::now() + std::chrono::seconds(waitSeconds);
+                        queue.push_back(page);
+                        std::cerr << "Kline backfill rate limited, retrying in " << waitSeconds << " s" << std::endl;
+                        return;
+                    }
+                    if (failed.count(page.symbol) > 0) return;
+                    try {
+                        if (!response.ok()) {
+                            throw std::runtime_error(response.errorMessage());
+                        }
+                        appendKlines(response.body, result[page.symbol]);
+                    } catch (const std::runtime_error& error) {
+                        failed.insert(page.symbol);
+                        std::cerr << "Kline backfill failed for " << page.symbol << ": " << error.what() << std::endl;
+                    }
+                });
+            }
+
+            if (http.inFlight() > 0) {
+                http.poll(100);
+            } else if (!queue.empty()) {
+                std::this_thread::sleep_until(pauseUntil);
+            }
+        }
+    }
+
+    static std::chrono::steady_clock::time_point nextMinute() {
+        auto now = std::chrono::system_clock::now();
+        auto sinceMinute = now.time_since_epoch() % std::chrono::minutes(1);
+        return std::chrono::steady_clock::now() + (std::chrono::minutes(1) - sinceMinute);
+    }
+
+    // 解析 [[openTime,"open","high","low","close",...], ...]
+    static void appendKlines(const std::string& body, std::vector<Kline>& bars) {
+        try {
+            nlohmann::json rows = nlohmann::json::parse(body);
+            for (const auto& row : rows) {
+                bars.push_back(Kline{
+                    row.at(0).get<long long>(),
+                    std::stod(row.at(1).get_ref<const std::string&>()),
+                    std::stod(row.at(2).get_ref<const std::string&>()),
+                    std::stod(row.at(3).get_ref<const std::string&>()),
+                    std::stod(row.at(4).get_ref<const std::string&>())
+                });
+            }
+        } catch (const nlohmann::json::exception& e) {
+            throw std::runtime_error("JSON parse error: " + std::string(e.what()));
+        } catch (const std::logic_error& e) {
+            // std::stod 對非數字或超出範圍的價格拋出 invalid_argument / out_of_range
+            throw std::runtime_error("Invalid kline price: " + std::string(e.what()));
+        }
+    }
+
+    // 排序、去重並只保留回補窗口內的K線
+    static void normalize(std::vector<Kline>& bars, long long windowStart) {
+        std::sort(bars.begin(), bars.end(),
+                  [](const Kline& a, const Kline& b) { return a.openTime < b.openTime; });
+        bars.erase(std::unique(bars.begin(), bars.end(),
+                               [](const Kline& a, const Kline& b) { return a.openTime == b.openTime; }),
+                   bars.end());
+        auto first = std::lower_bound(bars.begin(), bars.end(), windowStart,
+                                      [](const Kline& k, long long t) { return k.openTime < t; });
+        bars.erase(bars.begin(), first);
+    }
+
+    std::string cachePath(const std::string& symbol) const {
+        return cacheDir + "/" + symbol + "_" + interval + ".txt";
+    }
+
+    // 快取格式：每行 "openTime open high low close"
+    std::vector<Kline> loadCache(const std::string& symbol, long long windowStart) const {
+        std::vector<Kline> bars;
+        if (cacheDir.empty()) return bars;
+
+        std::ifstream cacheFile(cachePath(symbol));
+        Kline bar{0, 0, 0, 0, 0};
+        while (cacheFile >> bar.openTime >> bar.open >> bar.high >> bar.low >> bar.close) {
+            if (bar.openTime >= windowStart) {
+                bars.push_back(bar);
+            }
+        }
+        normalize(bars, windowStart);
+        return bars;
+    }
+
+    void saveCache(const std::string& symbol, const std::vector<Kline>& bars) const {
+        if (cacheDir.empty()) return;
+
+        std::error_code error;
+        std::filesystem::create_directories(cacheDir, error);
+        std::ofstream cacheFile(cachePath(symbol), std::ios::trunc);
+        if (!cacheFile.is_open()) {
+            std::cerr << "Failed to write kline cache for " << symbol << std::endl;
+            return;
+        }
+        cacheFile.precision(17);
+        for (const auto& bar : bars) {
+            cacheFile << bar.openTime << " " << bar.open << " " << bar.high << " "
+                      << bar.low << " " << bar.close << "\n";
+        }
+    }
+};
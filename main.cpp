@@ -6,162 +6,195 @@
 #include <stdexcept>
 #include <chrono>
 #include <thread>
+#include <tuple>
+#include <utility>
+#include <algorithm>
 #include <cmath>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
+#include <limits>
+#include <type_traits>
 #include <cstdlib>  // 用於 system 函數
+#include <cstring>
+#include <filesystem>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+#include "market_data_client.h"
+#include "price_stream.h"
+#include "order_book.h"
+#include "volatility.h"
+#include "kline_backfill.h"
+#include "poll_scheduler.h"
+#include "grid_cross.h"
+#include "grid_levels.h"
+#include "grid_geometry.h"
+#include "fixed_decimal.h"
+#include "object_pool.h"
+#include "pnl_ledger.h"
+#include "strategy_config.h"
+#include "config_watcher.h"
+#include "order_id.h"
+#include "seqlock.h"
+#include "price_channel.h"
+#include "order_gateway.h"
+#include "order_record.h"
+#include "binance_order_client.h"
+#include "pair_console.h"
 
 using json = nlohmann::json;
 
-static size_t WriteCallback(void *contents, size_t size, size_t nmemb, std::string *output) {
-    size_t totalSize = size * nmemb;
-    output->append((char*)contents, totalSize);
-    return totalSize;
-}
-
-
-/**
- * @brief 從Binance獲取指定交易對的當前價格
- * @param symbol 交易對名稱（例如："ETHUSDT", "BTCUSDT"）
- * @return 當前價格
- */
-double getCurrentPrice(const std::string& symbol) {
-    CURL *curl;
-    CURLcode res;
-    std::string readBuffer;
-
-    curl = curl_easy_init();
-    if (!curl) {
-        throw std::runtime_error("cURL init failed");
-    }
-
-    std::string url = "https://api.binance.com/api/v3/ticker/price?symbol=" + symbol;
-    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &readBuffer);
-    res = curl_easy_perform(curl);
-    curl_easy_cleanup(curl);
-
-    if (res != CURLE_OK) {
-        std::cerr << "cURL Error: " << std::to_string(res) << std::endl;
-        throw std::runtime_error("cURL Error: " + std::to_string(res));
-    }
-
-    try {
-        json response = json::parse(readBuffer);
-        std::string priceStr = response["price"].get<std::string>();
-        std::cout << "Current price fetched: " << priceStr << std::endl;
-        return std::stod(priceStr);
-    } catch (const json::parse_error& e) {
-        throw std::runtime_error("JSON parse error: " + std::string(e.what()));
-    } catch (const std::invalid_argument& e) {
-        throw std::runtime_error("Invalid argument in JSON response: " + std::string(e.what()));
-    }
-}
-
-void placeOrder(const std::string& side, double quantity, double price) {
-    std::cout << "Placing " << side << " order for " << quantity << " ETH at price " << price << std::endl;
-}
-
-double calculateDynamicGridSpacing(double volatility) {
+double calculateDynamicGridSpacing(double volatility, double multiplier = 0.01, double minSpacing = 0.5) {
     // 根据市场波动性计算动态网格间距
-    return std::max(0.5, volatility * 0.01); // 示例式
+    return std::max(minSpacing, volatility * multiplier);
 }
 
-// 訂單結構體
-struct Order {
-    std::string orderId;
-    std::string side;  // "buy" or "sell"
-    double price;
-    double quantity;
-    double gridLevel;  // 對應的網格線價格
-    bool isOpen;       // 訂單是否仍然有
-    
-    Order(const std::string& id, const std::string& s, double p, double q, double g)
-        : orderId(id), side(s), price(p), quantity(q), gridLevel(g), isOpen(true) {}
+// 單一網格線上的訂單句柄，每個方向至多一筆活躍訂單，以及該網格線的已實現盈虧
+struct LevelOrders {
+    PoolHandle buy = INVALID_POOL_HANDLE;
+    PoolHandle sell = INVALID_POOL_HANDLE;
+    LevelPnl pnl;
+    
+    PoolHandle& forSide(OrderSide side) { return side == OrderSide::Buy ? buy : sell; }
+    PoolHandle forSide(OrderSide side) const { return side == OrderSide::Buy ? buy : sell; }
 };
 
 // 倉位信息結構體
 struct Position {
-    double quantity;      // 當前持倉數量
-    double avgPrice;      // 平均持倉價格
-    double totalCost;     // 總成本
-    double unrealizedPnL; // 未實現盈虧
-    
-    Position() : quantity(0), avgPrice(0), totalCost(0), unrealizedPnL(0) {}
+    Quantity quantity;       // 當前持倉數量
+    Price avgPrice;          // 平均持倉價格
+    Notional totalCost;      // 總成本
+    Notional unrealizedPnL;  // 未實現盈虧
 };
 
 // 風險管理類
 class RiskManager {
 private:
-    double maxPositionSize;    // 最大持倉數量
-    double maxDrawdown;        // 最大回撤限制
-    double initialEquity;      // 初始資金
-    double currentEquity;      // 當前資金
-    double maxLossPerTrade;    // 單筆最大虧損限制
+    Quantity maxPositionSize;  // 最大持倉數量
+    Notional maxDrawdown;      // 最大回撤限制
+    Notional initialEquity;    // 初始資金
+    Notional currentEquity;    // 當前資金
+    Notional maxLossPerTrade;  // 單筆最大虧損限制
+    std::ostream& console;     // 風控訊息輸出
     
 public:
-    RiskManager(double initialEquity, double maxPositionSize, double maxDrawdownPercent, double maxLossPercent)
+    RiskManager(Notional initialEquity, Quantity maxPositionSize, double maxDrawdownPercent, double maxLossPercent,
+                std::ostream& out = std::cout)
         : initialEquity(initialEquity)
         , currentEquity(initialEquity)
         , maxPositionSize(maxPositionSize)
-        , maxDrawdown(initialEquity * maxDrawdownPercent)
-        , maxLossPerTrade(initialEquity * maxLossPercent) {}
+        , maxDrawdown(Notional::fromUnits(std::llround(initialEquity.raw() * maxDrawdownPercent)))
+        , maxLossPerTrade(Notional::fromUnits(std::llround(initialEquity.raw() * maxLossPercent)))
+        , console(out) {}
     
-    bool canPlaceOrder(const std::string& side, double quantity, double price) {
+    bool canPlaceOrder(OrderSide side, Quantity quantity, Price price) {
         // 檢查持倉限制
         if (quantity > maxPositionSize) {
-            std::cout << "Order rejected: Exceeds maximum position size" << std::endl;
+            console << "Order rejected: Exceeds maximum position size" << std::endl;
             return false;
         }
         
         // 檢查資金是否足夠
-        double orderCost = quantity * price;
+        Notional orderCost = price * quantity;
         if (orderCost > currentEquity) {
-            std::cout << "Order rejected: Insufficient funds" << std::endl;
+            console << "Order rejected: Insufficient funds" << std::endl;
             return false;
         }
         
         return true;
     }
     
-    void updateEquity(double pnl) {
+    void updateEquity(Notional pnl) {
         currentEquity += pnl;
-        double drawdown = initialEquity - currentEquity;
+        Notional drawdown = initialEquity - currentEquity;
         
         if (drawdown > maxDrawdown) {
-            std::cout << "WARNING: Maximum drawdown exceeded!" << std::endl;
+            console << "WARNING: Maximum drawdown exceeded!" << std::endl;
         }
     }
     
-    double getCurrentEquity() const { return currentEquity; }
+    // 熱重載時更新限額，資金狀態保持不變
+    void setLimits(Quantity positionLimit, double maxDrawdownPercent, double maxLossPercent) {
+        maxPositionSize = positionLimit;
+        maxDrawdown = Notional::fromUnits(std::llround(initialEquity.raw() * maxDrawdownPercent));
+        maxLossPerTrade = Notional::fromUnits(std::llround(initialEquity.raw() * maxLossPercent));
+    }
+    
+    Notional getCurrentEquity() const { return currentEquity; }
 };
 
 // 網格訂單管理類
 class GridOrderManager {
 private:
-    std::map<double, std::vector<Order>> gridOrders;  // 每個網格線對應的訂單
-    double gridSpacing;
-    double minOrderQuantity;
+    DecimalScale scale;  // 價格與數量的小數位數
+    ObjectPool<Order> orderPool;  // 活躍訂單，關閉後槽位回收、訂單移入歸檔
+    GridLevelRing<LevelOrders> gridOrders;  // 網格索引 -> 該網格線上的訂單句柄
+    GridGeometry geometry;  // 網格線位置
+    Quantity minOrderQuantity;
     Position position;
     RiskManager riskManager;
-    std::map<std::string, double> realizedPnL;  // 已實現盈虧記錄
+    PnlLedger pnlLedger;  // 已實現盈虧帳本
     std::ofstream logFile;  // 日誌文件
-    const json& config;  // 存儲配置引用
+    std::string dataFilePath;     // 圖表數據文件
+    std::string chartOutputPath;  // 圖表輸出路徑
+    std::vector<PoolHandle> carriedOrders;  // 間距改變時暫存的訂單句柄
+    std::vector<std::pair<Price, LevelPnl>> carriedPnl;  // 間距改變時暫存的網格線盈虧（按網格線價格）
+    OrderIdGenerator& orderIds;  // 訂單ID生成器，可由多個策略共享
+    OrderGateway& gateway;       // 非同步訂單閘道，可由多個策略共享
+    uint32_t gatewaySlot;        // 在所屬閘道中的回報佇列編號
+    uint32_t symbolId;           // 寫入訂單ID的交易對編號
+    std::ostream& console;       // 訂單與統計訊息輸出
+    uint64_t acknowledgedOrders = 0;  // 交易所已接受的訂單數
+    uint64_t rejectedOrders = 0;      // 被拒絕的訂單數
+    
+    static constexpr size_t TOP_LEVELS_SHOWN = 3;  // 統計輸出中列出的網格線數
     
 public:
-    GridOrderManager(const json& cfg) 
-        : config(cfg)
-        , gridSpacing(cfg["grid_spacing"])
-        , minOrderQuantity(cfg["min_order_quantity"])
+    /**
+     * @param config 策略配置
+     * @param idGenerator 訂單ID生成器，可由多個策略共享
+     * @param orderGateway 訂單閘道，可由多個策略共享
+     * @param slot 在 orderGateway 中的回報佇列編號
+     * @param symbol 交易對編號（0 到 OrderIdGenerator::MAX_SYMBOLS - 1）
+     * @param out 訂單與統計訊息的輸出流（分片模式下每個分片各自一個）
+     */
+    GridOrderManager(const StrategyConfig& config, OrderIdGenerator& idGenerator, OrderGateway& orderGateway,
+                     uint32_t slot, uint32_t symbol = 0, std::ostream& out = std::cout)
+        : scale(config.scale)
+        , orderPool(config.orderArchiveSize)
+        , gridOrders(2 * static_cast<size_t>(config.gridCount) + 1)
+        , geometry(
+            config.gridSpacingMode,
+            config.configuredGridSpacing(),
+            !config.infiniteGrid,
+            config.lowerPriceLimit,
+            config.upperPriceLimit)
+        , minOrderQuantity(config.minOrderQuantity)
         , riskManager(
-            cfg["initial_investment"],
-            cfg["max_position_size"],
-            cfg["max_drawdown_percent"],
-            cfg["max_loss_per_trade_percent"]
-          ) {
+            config.initialInvestment,
+            config.maxPositionSize,
+            config.maxDrawdownPercent,
+            config.maxLossPerTradePercent,
+            out
+          )
+        , dataFilePath(config.dataFilePath)
+        , chartOutputPath(config.chartOutputPath)
+        , orderIds(idGenerator)
+        , gateway(orderGateway)
+        , gatewaySlot(slot)
+        , symbolId(symbol)
+        , console(out) {
+        if (symbol >= OrderIdGenerator::MAX_SYMBOLS) {
+            throw std::runtime_error("Symbol id out of range");
+        }
+        geometry.setSpacing(roundSpacing(geometry.getSpacing(), 0));
+        
         // 初始化日誌
-        logFile.open(config["log_file_path"].get<std::string>(), std::ios::app);
+        logFile.open(config.logFilePath, std::ios::app);
         if (!logFile.is_open()) {
             std::cerr << "Failed to open log file!" << std::endl;
         }
@@ -173,243 +206,1191 @@ public:
         }
     }
     
+    const DecimalScale& getScale() const { return scale; }
+    const GridGeometry& getGeometry() const { return geometry; }
+    std::ostream& getConsole() const { return console; }
+    size_t activeOrderCount() const { return orderPool.liveCount(); }
+    const Position& getPosition() const { return position; }
+    const PnlLedger& getPnlLedger() const { return pnlLedger; }
+    
+    // 套用熱重載的配置；網格間距與數量由下一次行情的 setGridSpacing/updateGridWindow 處理
+    void applyConfig(const StrategyConfig& config) {
+        minOrderQuantity = config.minOrderQuantity;
+        riskManager.setLimits(config.maxPositionSize, config.maxDrawdownPercent, config.maxLossPerTradePercent);
+        geometry.setBounds(!config.infiniteGrid, config.lowerPriceLimit, config.upperPriceLimit);
+        dataFilePath = config.dataFilePath;
+        chartOutputPath = config.chartOutputPath;
+    }
+    
     // 添加新訂單
-    bool addOrder(const std::string& side, double price, double gridLevel) {
+    bool addOrder(OrderSide side, Price price, Price gridLevel) {
         // 檢查風險限制
         if (!riskManager.canPlaceOrder(side, minOrderQuantity, price)) {
             return false;
         }
         
-        std::string orderId = generateOrderId();
-        Order order(orderId, side, price, minOrderQuantity, gridLevel);
-        gridOrders[gridLevel].push_back(order);
+        long long levelIndex = levelIndexOf(gridLevel);
+        if (!gridOrders.contains(levelIndex)) {
+            console << "Order rejected: Grid level " << scale.format(gridLevel) << " outside active grid" << std::endl;
+            return false;
+        }
         
-        // 更新倉位
-        if (side == "buy") {
-            updatePosition(minOrderQuantity, price, true);
-        } else {
-            updatePosition(minOrderQuantity, price, false);
+        PoolHandle& handle = gridOrders.get(levelIndex).forSide(side);
+        if (handle != INVALID_POOL_HANDLE) {
+            console << "Order rejected: Open " << sideName(side) << " order already at grid level "
+                      << scale.format(gridLevel) << std::endl;
+            return false;
         }
         
-        std::cout << "New " << side << " order placed at grid level " << gridLevel 
-                 << " (Price: " << price << ")" << std::endl;
+        // 交給訂單閘道非同步送出，閘道佇列已滿時不等待，直接放棄本次下單
+        Order order{orderIds.next(symbolId, levelIndex), price, minOrderQuantity, gridLevel, side, ORDER_OPEN};
+        PoolHandle acquired = orderPool.acquire(order);
+        if (!gateway.submit(OrderRequest{order.orderId, order.orderId, price, minOrderQuantity, gatewaySlot, acquired,
+                                         OrderAction::New, side})) {
+            orderPool.get(acquired).status = ORDER_CLOSED | ORDER_REJECTED;
+            orderPool.release(acquired);
+            rejectedOrders++;
+            console << "Order rejected: Order gateway queue full" << std::endl;
+            return false;
+        }
+        handle = acquired;
+        
+        // 模擬撮合不回報成交，按下單即成交記帳；實盤等交易所回報成交後才記帳
+        if (gateway.simulated()) {
+            updatePosition(minOrderQuantity, price, side == OrderSide::Buy, &gridOrders.get(levelIndex).pnl);
+        }
+        
+        console << "New " << sideName(side) << " order placed at grid level " << scale.format(gridLevel) 
+                 << " (Price: " << scale.format(price) << ")" << std::endl;
         
         // 記錄日誌
         if (logFile.is_open()) {
-            logFile << "New " << side << " order placed at grid level " << gridLevel 
-                    << " (Price: " << price << ", Quantity: " << minOrderQuantity << ")\n";
+            logFile << "New " << sideName(side) << " order placed at grid level " << scale.format(gridLevel) 
+                    << " (Price: " << scale.format(price) << ", Quantity: " << scale.format(minOrderQuantity) << ")\n";
         }
         
         return true;
     }
     
-    // 更新網格系統
-    void updateGrids(double currentPrice, const std::vector<double>& newGridLevels) {
-        // 關閉超出新網格範圍的訂單
-        auto it = gridOrders.begin();
-        while (it != gridOrders.end()) {
-            if (std::find(newGridLevels.begin(), newGridLevels.end(), it->first) == newGridLevels.end()) {
-                closeOrdersAtGrid(it->first);
-                it = gridOrders.erase(it);
-            } else {
-                ++it;
+    /**
+     * @brief 處理訂單閘道送回的回報，在處理行情前呼叫
+     *
+     * 被拒絕的新訂單從網格上移除；撤單失敗與狀態查詢失敗只記入日誌，不計為拒單。
+     * 狀態輪詢發現已在交易所撤銷的訂單同樣從網格上移除。
+     * 成交與部分成交回報按新增的成交價格與數量記帳（部分成交後撤銷的訂單同樣記入），
+     * 已關閉訂單的成交同樣記入倉位，但不再計入網格線盈虧。
+     * 句柄可能已因撤單而被重用，以訂單ID核對後才更新。
+     */
+    void processReplies() {
+        gateway.drainReplies(gatewaySlot, [this](const OrderReply& reply) {
+            Order* order = reply.handle != INVALID_POOL_HANDLE ? &orderPool.get(reply.handle) : nullptr;
+            bool current = order != nullptr && order->orderId == reply.orderId && order->isOpen();
+            switch (reply.type) {
+                case OrderReplyType::Accepted:
+                    // 狀態輪詢確認訂單仍在掛單中，不重複計數
+                    if (reply.action != OrderAction::Query) acknowledgedOrders++;
+                    if (current) order->status |= ORDER_ACKED;
+                    break;
+                case OrderReplyType::Rejected:
+                    if (reply.action == OrderAction::Cancel || reply.action == OrderAction::Query) {
+                        if (logFile.is_open()) {
+                            logFile << (reply.action == OrderAction::Cancel ? "Cancel" : "Status query") << " for order "
+                                    << OrderIdGenerator::encode(reply.orderId) << " failed: "
+                                    << reply.reason << " (code " << reply.errorCode << ")\n";
+                        }
+                        break;
+                    }
+                    rejectedOrders++;
+                    console << "Order " << OrderIdGenerator::encode(reply.orderId) << " rejected: "
+                            << reply.reason << " (code " << reply.errorCode << ")" << std::endl;
+                    if (current) removeOrder(reply.handle, ORDER_CLOSED | ORDER_REJECTED);
+                    break;
+                case OrderReplyType::Canceled:
+                    if (logFile.is_open()) {
+                        logFile << "Order " << OrderIdGenerator::encode(reply.orderId) << " canceled\n";
+                    }
+                    // 狀態輪詢發現訂單已在交易所撤銷或過期：從網格移除，之後可在該網格線重新下單
+                    if (current && reply.action == OrderAction::Query) {
+                        console << "Order " << OrderIdGenerator::encode(reply.orderId)
+                                << " canceled by the exchange" << std::endl;
+                        removeOrder(reply.handle, ORDER_CLOSED);
+                    }
+                    break;
+                case OrderReplyType::Filled:
+                case OrderReplyType::PartiallyFilled: {
+                    bool complete = reply.type == OrderReplyType::Filled;
+                    LevelPnl* level = nullptr;
+                    if (current) {
+                        // 立即成交的新訂單不會另有 Accepted 回報
+                        if (complete && !(order->status & ORDER_ACKED)) acknowledgedOrders++;
+                        if (complete) order->status |= ORDER_ACKED | ORDER_FILLED;
+                        LevelOrders* orders = gridOrders.find(levelIndexOf(order->gridLevel));
+                        level = orders != nullptr ? &orders->pnl : nullptr;
+                    }
+                    // 成交已由先前的部分成交回報記帳時，Filled 的新增數量為0
+                    if (reply.quantity == Quantity()) break;
+                    if (logFile.is_open()) {
+                        logFile << "Order " << OrderIdGenerator::encode(reply.orderId)
+                                << (complete ? " filled: Price: " : " partially filled: Price: ")
+                                << scale.format(reply.price) << ", Quantity: " << scale.format(reply.quantity) << "\n";
+                    }
+                    updatePosition(reply.quantity, reply.price, reply.side == OrderSide::Buy, level);
+                    break;
+                }
+            }
+        }, std::numeric_limits<size_t>::max());
+    }
+    
+    // 網格索引 -> 網格線價格（取整到最小價格單位）
+    Price levelPrice(long long levelIndex) const {
+        return scale.toPrice(geometry.levelPrice(levelIndex));
+    }
+    
+    /**
+     * @brief 設定網格間距（等差為價格，等比為比例）
+     *
+     * 間距改變時以原窗口中心價格重新錨定窗口，原有訂單與網格線盈虧按其網格線價格重新映射：
+     * 仍落在新網格線上的保留，其餘訂單關閉、盈虧不再按網格線統計（總額仍在帳本中）。
+     * 等比網格的比例低於 tick / 當前價格時相鄰網格線會取整到同一價格，此時提高到該下限。
+     * @param price 當前價格
+     */
+    void setGridSpacing(double spacing, double price) {
+        double minimum = geometry.minimumSpacing(scale.toDouble(Price::fromUnits(1)), price);
+        double rounded = roundSpacing(spacing, minimum);
+        if (rounded == geometry.getSpacing()) return;
+        if (rounded > roundSpacing(spacing, 0)) {
+            console << "Grid spacing raised to " << rounded << ": levels near " << price
+                    << " would be less than one price tick apart" << std::endl;
+        }
+        
+        Price center = levelPrice(gridOrders.firstIndex() + static_cast<long long>(gridOrders.capacity() / 2));
+        carriedOrders.clear();
+        carriedPnl.clear();
+        gridOrders.clear([this](long long index, LevelOrders& orders) {
+            for (PoolHandle handle : {orders.buy, orders.sell}) {
+                if (handle != INVALID_POOL_HANDLE) carriedOrders.push_back(handle);
+            }
+            if (orders.pnl.closingSells > 0) carriedPnl.emplace_back(levelPrice(index), orders.pnl);
+        });
+        
+        geometry.setSpacing(rounded);
+        gridOrders.setWindow(levelIndexOf(center) - static_cast<long long>(gridOrders.capacity() / 2),
+                             [](long long, LevelOrders&) {});
+        for (PoolHandle handle : carriedOrders) {
+            const Order& order = orderPool.get(handle);
+            long long levelIndex = levelIndexOf(order.gridLevel);
+            if (levelPrice(levelIndex) == order.gridLevel && gridOrders.contains(levelIndex)) {
+                PoolHandle& slot = gridOrders.get(levelIndex).forSide(order.side);
+                if (slot == INVALID_POOL_HANDLE) {
+                    slot = handle;
+                    continue;
+                }
             }
+            closeOrder(handle, order.gridLevel);
         }
+        for (const auto& [gridLevel, pnl] : carriedPnl) {
+            long long levelIndex = levelIndexOf(gridLevel);
+            if (levelPrice(levelIndex) == gridLevel && gridOrders.contains(levelIndex)) {
+                gridOrders.get(levelIndex).pnl = pnl;
+            }
+        }
+    }
+    
+    /**
+     * @brief 將網格窗口移到 [minIndex, maxIndex]
+     *
+     * 基準網格移動 k 格時只關閉移出窗口的 k 條網格線上的訂單，
+     * 基準網格未移動時不做任何事。
+     */
+    void updateGridWindow(long long minIndex, long long maxIndex) {
+        size_t levelCount = static_cast<size_t>(maxIndex - minIndex + 1);
+        
+        auto closeLevel = [this](long long index, LevelOrders& orders) {
+            closeOrders(orders, levelPrice(index));
+        };
+        
+        // 網格數量改變時調整環形陣列容量，保留仍在新窗口內的訂單
+        if (levelCount != gridOrders.capacity()) {
+            gridOrders.resize(levelCount, minIndex, closeLevel);
+            return;
+        }
+        
+        // 關閉超出新網格範圍的訂單
+        gridOrders.setWindow(minIndex, closeLevel);
     }
     
     // 檢查是否需要在特定網格線開立新訂單
-    bool shouldPlaceOrderAtGrid(double gridLevel, const std::string& side) {
-        auto it = gridOrders.find(gridLevel);
-        if (it == gridOrders.end()) return true;
+    bool shouldPlaceOrderAtGrid(Price gridLevel, OrderSide side) {
+        const LevelOrders* orders = gridOrders.find(levelIndexOf(gridLevel));
         
         // 檢查是否已有相同方向的活躍訂單
-        for (const auto& order : it->second) {
-            if (order.isOpen && order.side == side) {
-                return false;
-            }
-        }
-        return true;
+        return orders == nullptr || orders->forSide(side) == INVALID_POOL_HANDLE;
     }
     
     // 打���當前活躍訂單
     void printActiveOrders() const {
-        std::cout << "\nActive Orders:" << std::endl;
-        for (const auto& [grid, orders] : gridOrders) {
-            for (const auto& order : orders) {
-                if (order.isOpen) {
-                    std::cout << "Grid " << grid << ": " 
-                            << order.side << " order at " << order.price 
-                            << " (Quantity: " << order.quantity << ")" << std::endl;
+        console << "\nActive Orders:" << std::endl;
+        for (long long k = gridOrders.firstIndex(); k <= gridOrders.lastIndex(); k++) {
+            const LevelOrders* orders = gridOrders.find(k);
+            if (orders == nullptr) continue;
+            for (PoolHandle handle : {orders->buy, orders->sell}) {
+                if (handle != INVALID_POOL_HANDLE) {
+                    const Order& order = orderPool.get(handle);
+                    console << "Grid " << scale.format(levelPrice(k)) << ": " 
+                            << sideName(order.side) << " order at " << scale.format(order.price) 
+                            << " (Quantity: " << scale.format(order.quantity) << ")" << std::endl;
                 }
             }
         }
     }
     
-    // 更新倉位信息
-    void updatePosition(double quantity, double price, bool isBuy) {
+    /**
+     * @brief 按成交更新倉位信息
+     * @param level 成交所在網格線的盈虧，網格線已移出窗口時為 nullptr
+     */
+    void updatePosition(Quantity quantity, Price price, bool isBuy, LevelPnl* level) {
         if (isBuy) {
-            double newQuantity = position.quantity + quantity;
-            position.avgPrice = (position.quantity * position.avgPrice + quantity * price) / newQuantity;
+            Quantity newQuantity = position.quantity + quantity;
+            position.avgPrice = averagePrice(position.quantity * position.avgPrice + quantity * price, newQuantity);
             position.quantity = newQuantity;
             position.totalCost += quantity * price;
         } else {
             position.quantity -= quantity;
             // 計算已實現盈虧
-            double pnl = (price - position.avgPrice) * quantity;
-            realizedPnL[generateOrderId()] = pnl;
+            Notional pnl = (price - position.avgPrice) * quantity;
+            pnlLedger.record(pnl, currentTimeMs());
             riskManager.updateEquity(pnl);
+            
+            // 網格線已移出窗口時不再累計該網格線的盈虧
+            if (level != nullptr) {
+                level->realized += pnl;
+                level->closingSells++;
+            }
+            
+            if (logFile.is_open()) {
+                logFile << "Sell executed: Price: " << scale.format(price) << ", Quantity: " << scale.format(quantity) 
+                        << ", PnL: " << scale.format(pnl);
+                if (level != nullptr) {
+                    logFile << ", Grid P&L: " << scale.format(level->realized)
+                            << " over " << level->closingSells << " closing sells";
+                }
+                logFile << "\n";
+            }
+            return;
         }
         
         // 記錄日誌
         if (logFile.is_open()) {
-            logFile << (isBuy ? "Buy" : "Sell") << " executed: " 
-                    << "Price: " << price << ", Quantity: " << quantity 
-                    << ", PnL: " << (isBuy ? 0 : (price - position.avgPrice) * quantity) << "\n";
+            logFile << "Buy executed: Price: " << scale.format(price) << ", Quantity: " << scale.format(quantity) 
+                    << ", PnL: " << scale.format(Notional()) << "\n";
         }
     }
     
     // 打印交易統計
-    void printTradingStats(double currentPrice) const {
-        std::cout << "\n=== Trading Statistics ===" << std::endl;
-        std::cout << "Current Position:" << std::endl;
-        std::cout << "Quantity: " << position.quantity << std::endl;
-        std::cout << "Average Price: " << position.avgPrice << std::endl;
+    void printTradingStats(Price currentPrice) const {
+        console << "\n=== Trading Statistics ===" << std::endl;
+        console << "Current Position:" << std::endl;
+        console << "Quantity: " << scale.format(position.quantity) << std::endl;
+        console << "Average Price: " << scale.format(position.avgPrice) << std::endl;
         
         // 計算未實現盈虧
-        double unrealizedPnL = position.quantity * (currentPrice - position.avgPrice);
-        std::cout << "Unrealized P&L: " << unrealizedPnL << std::endl;
+        Notional unrealizedPnL = position.quantity * (currentPrice - position.avgPrice);
+        console << "Unrealized P&L: " << scale.format(unrealizedPnL) << std::endl;
         
-        // 計算總實現盈虧
-        double totalRealizedPnL = 0;
-        for (const auto& [orderId, pnl] : realizedPnL) {
-            totalRealizedPnL += pnl;
-        }
-        std::cout << "Total Realized P&L: " << totalRealizedPnL << std::endl;
+        // 已實現盈虧（帳本匯總值）
+        long long now = currentTimeMs();
+        console << "Total Realized P&L: " << scale.format(pnlLedger.total()) << std::endl;
+        console << "Realized P&L 1h / 24h / 30d: " << scale.format(pnlLedger.lastHour(now)) << " / "
+                  << scale.format(pnlLedger.lastDay(now)) << " / " << scale.format(pnlLedger.last30Days(now)) << std::endl;
+        console << "Closed Trades: " << pnlLedger.tradeCount() << " (" << pnlLedger.winningTrades()
+                  << " profitable)" << std::endl;
+        printTopLevels();
         
         // 顯示當前資金
-        std::cout << "Current Equity: " << riskManager.getCurrentEquity() << std::endl;
+        console << "Current Equity: " << scale.format(riskManager.getCurrentEquity()) << std::endl;
+        console << "Orders: " << orderPool.liveCount() << " open, " << orderPool.totalReleased()
+                  << " closed (" << orderPool.archivedCount() << " archived)" << std::endl;
+        console << "Exchange: " << acknowledgedOrders << " acknowledged, " << rejectedOrders
+                  << " rejected" << std::endl;
         
         // 注释掉图表生成
         // generateChart();
     }
     
+    // 打印已實現盈虧最高的幾條網格線（只統計目前窗口內的網格線）
+    void printTopLevels() const {
+        std::vector<std::pair<long long, const LevelPnl*>> levels;
+        for (long long k = gridOrders.firstIndex(); k <= gridOrders.lastIndex(); k++) {
+            const LevelOrders* orders = gridOrders.find(k);
+            if (orders != nullptr && orders->pnl.closingSells > 0) levels.emplace_back(k, &orders->pnl);
+        }
+        if (levels.empty()) return;
+        
+        size_t shown = std::min(levels.size(), TOP_LEVELS_SHOWN);
+        std::partial_sort(levels.begin(), levels.begin() + shown, levels.end(),
+                          [](const auto& a, const auto& b) { return a.second->realized > b.second->realized; });
+        console << "Top Grid Levels by Realized P&L:" << std::endl;
+        for (size_t i = 0; i < shown; i++) {
+            console << "  Grid " << scale.format(levelPrice(levels[i].first)) << ": "
+                    << scale.format(levels[i].second->realized) << " over "
+                    << levels[i].second->closingSells << " closing sells" << std::endl;
+        }
+    }
+    
     // 添加生成圖表的方法
     void generateChart() const {
-        std::ofstream dataFile(config["data_file_path"].get<std::string>());
+        std::ofstream dataFile(dataFilePath);
         if (!dataFile.is_open()) {
             std::cerr << "Failed to open data file!" << std::endl;
             return;
         }
         
         // 寫入數據
-        for (const auto& [grid, orders] : gridOrders) {
-            for (const auto& order : orders) {
-                if (order.isOpen) {
-                    dataFile << grid << " " << order.price << " " << order.quantity << "\n";
+        for (long long k = gridOrders.firstIndex(); k <= gridOrders.lastIndex(); k++) {
+            const LevelOrders* orders = gridOrders.find(k);
+            if (orders == nullptr) continue;
+            for (PoolHandle handle : {orders->buy, orders->sell}) {
+                if (handle != INVALID_POOL_HANDLE) {
+                    const Order& order = orderPool.get(handle);
+                    dataFile << scale.format(levelPrice(k)) << " " << scale.format(order.price) << " "
+                             << scale.format(order.quantity) << "\n";
                 }
             }
         }
         dataFile.close();
         
         std::string command = "gnuplot -e \"set terminal png; set output '" + 
-            config["chart_output_path"].get<std::string>() + 
-            "'; plot '" + config["data_file_path"].get<std::string>() + 
+            chartOutputPath + 
+            "'; plot '" + dataFilePath + 
             "' using 1:2 with linespoints\"";
         system(command.c_str());
     }
     
 private:
-    // 生成唯一訂單ID
-    std::string generateOrderId() {
-        static int orderCounter = 0;
-        return "ORDER_" + std::to_string(++orderCounter);
-    }
-    
-    // 關閉特定網格線上的所有訂單
-    void closeOrdersAtGrid(double gridLevel) {
-        auto it = gridOrders.find(gridLevel);
-        if (it != gridOrders.end()) {
-            for (auto& order : it->second) {
-                if (order.isOpen) {
-                    order.isOpen = false;
-                    std::cout << "Closing order " << order.orderId 
-                             << " at grid level " << gridLevel << std::endl;
-                }
-            }
+    static long long currentTimeMs() {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+    
+    // 網格線價格 -> 網格索引
+    long long levelIndexOf(Price gridLevel) const {
+        return geometry.indexOf(scale.toDouble(gridLevel));
+    }
+    
+    // 間距取整以免每筆行情都微調網格：等差取整到最小價格單位，等比取整到 0.01%，且不低於 minimum
+    double roundSpacing(double spacing, double minimum) const {
+        double step = geometry.getMode() == GridGeometry::Mode::Arithmetic
+            ? scale.toDouble(Price::fromUnits(1))
+            : 0.0001;
+        double lowest = std::max(step, std::ceil(minimum / step - 1e-9) * step);
+        return std::max(lowest, std::round(spacing / step) * step);
+    }
+    
+    // 關閉網格線上的訂單
+    void closeOrders(LevelOrders& orders, Price gridLevel) {
+        for (PoolHandle* handle : {&orders.buy, &orders.sell}) {
+            if (*handle == INVALID_POOL_HANDLE) continue;
+            closeOrder(*handle, gridLevel);
+            *handle = INVALID_POOL_HANDLE;
         }
     }
+    
+    // 關閉單筆訂單：經訂單閘道撤單（已成交的不再撤單），釋放池中槽位，訂單移入歸檔
+    void closeOrder(PoolHandle handle, Price gridLevel) {
+        Order& order = orderPool.get(handle);
+        bool filled = order.status & ORDER_FILLED;
+        order.close();
+        console << "Closing order " << OrderIdGenerator::encode(order.orderId) 
+                 << " at grid level " << scale.format(gridLevel) << std::endl;
+        if (!filled && !gateway.submit(OrderRequest{order.orderId, order.orderId, order.price, order.quantity, gatewaySlot, handle,
+                                         OrderAction::Cancel, order.side})) {
+            console << "Cancel for order " << OrderIdGenerator::encode(order.orderId)
+                    << " not sent: Order gateway queue full" << std::endl;
+        }
+        orderPool.release(handle);
+    }
+    
+    // 移除已不在交易所掛單的訂單（被拒絕或已撤銷）：清除網格上的句柄，釋放槽位
+    void removeOrder(PoolHandle handle, uint8_t status) {
+        Order& order = orderPool.get(handle);
+        LevelOrders* orders = gridOrders.find(levelIndexOf(order.gridLevel));
+        if (orders != nullptr && orders->forSide(order.side) == handle) {
+            orders->forSide(order.side) = INVALID_POOL_HANDLE;
+        }
+        order.status = status;
+        orderPool.release(handle);
+    }
+};
+
+// 單一交易對的策略狀態
+// 發布給彙總報告的單一交易對統計
+struct PairStats {
+    uint64_t ticks;
+    uint64_t openOrders;
+    uint64_t closedTrades;
+    uint64_t winningTrades;
+    double lastPrice;
+    double position;     // 持倉數量
+    double realizedPnl;  // 累計已實現盈虧（報價貨幣）
+};
+
+struct StrategyState {
+    PairConsole console;      // 訂單與狀態輸出，每行帶交易對前綴，須先於訂單管理建構
+    GridOrderManager orderManager;
+    VolatilityEstimator volatility;
+    GridCrossDetector crossDetector;
+    std::vector<GridCross> crosses;  // 重用的穿越批次
+    AdaptivePollScheduler scheduler;  // 輪詢模式的取價間隔
+    size_t pairIndex;  // 在配置 pairs 中的位置
+    const StrategyConfig* activeConfig;  // 目前套用的配置快照
+    std::chrono::steady_clock::time_point lastReport;  // 上次打印狀態的時間
+    std::atomic<long long> nextPollMs{0};  // 輪詢模式下要求的下一次取價時間（steady_clock 毫秒）
+    uint64_t ticks = 0;       // 已處理的行情筆數
+    uint64_t conflatedEvents = 0;  // pooled 模式下工作執行緒落後時被合併的行情筆數
+    SeqlockSlot<PairStats> stats;  // 發布給彙總報告的統計，只由處理該交易對的執行緒寫入
+    
+    /**
+     * @param config 該交易對的配置
+     * @param index 在配置 pairs 中的位置，同時作為訂單ID中的交易對編號
+     * @param orderIds 訂單ID生成器
+     * @param gateway 訂單閘道
+     * @param gatewaySlot 在 gateway 中的回報佇列編號
+     * @param out 訂單與狀態輸出
+     * @param outLock 共用 out 時的輸出鎖，獨佔時為 nullptr
+     */
+    StrategyState(const StrategyConfig& config, size_t index, OrderIdGenerator& orderIds, OrderGateway& gateway,
+                  uint32_t gatewaySlot, std::ostream& out, std::mutex* outLock)
+        : console(out, outLock, config.tradingPair)
+        , orderManager(config, orderIds, gateway, gatewaySlot, static_cast<uint32_t>(index), console)
+        , volatility(
+            config.volatilityKlineInterval,
+            config.volatilitySource,
+            config.ewmaLambda,
+            config.atrPeriod,
+            config.realizedVolatilityWindows)
+        , scheduler(
+            config.minPollIntervalMs,
+            config.maxPollIntervalMs,
+            config.updateIntervalSeconds * 1000,
+            config.pollSafetyFactor)
+        , pairIndex(index)
+        , activeConfig(&config) {}
+};
+
+// 取得該交易對最新的配置快照；快照已更換時把新參數套用到訂單管理與輪詢間隔
+// 網格間距與數量由隨後的 onPriceUpdate 以增量方式重新錨定
+const StrategyConfig& refreshConfig(StrategyState& state, const ConfigWatcher& watcher) {
+    const StrategyConfig* latest = &watcher.snapshot()->pairs[state.pairIndex];
+    if (latest != state.activeConfig) {
+        state.orderManager.applyConfig(*latest);
+        state.scheduler.setIntervals(
+            latest->minPollIntervalMs,
+            latest->maxPollIntervalMs,
+            latest->updateIntervalSeconds * 1000,
+            latest->pollSafetyFactor);
+        state.activeConfig = latest;
+        state.console << "Configuration reloaded" << std::endl;
+    }
+    return *latest;
+}
+
+// 單次價格更新後的網格狀態
+struct GridTickResult {
+    double baseGrid;              // 基準網格
+    double gridSpacing;           // 本次使用的網格間距（等差為價格，等比為比例）
+    double nearestLevelDistance;  // 到最近未觸發網格線觸發區的價格距離
 };
 
-// 修改 gridTrading 函數
-void gridTrading(const json& config) {
-    static GridOrderManager orderManager(config);
-    
-    double currentPrice = getCurrentPrice(config["trading_pair"]);
-    const int GRID_COUNT = config["grid_count"];
-    double gridSpacing = config["grid_spacing"];
-    
-    // 計算網格線
-    double baseGrid = std::round(currentPrice / gridSpacing) * gridSpacing;
-    std::vector<double> gridLevels;
-    for (int i = -GRID_COUNT; i <= GRID_COUNT; i++) {
-        gridLevels.push_back(baseGrid + (i * gridSpacing));
-    }
-    
-    // 更新訂單管理系統
-    orderManager.updateGrids(currentPrice, gridLevels);
-    
-    // 檢查每個網格線是否需要開立新訂單
-    for (size_t i = 0; i < gridLevels.size() - 1; i++) {
-        double lowerGrid = gridLevels[i];
-        double upperGrid = gridLevels[i + 1];
-        
-        if (currentPrice > lowerGrid && currentPrice <= upperGrid) {
-            // 檢查是否需要在下方網格線買入
-            if (std::abs(currentPrice - lowerGrid) < gridSpacing * 0.1) {
-                if (orderManager.shouldPlaceOrderAtGrid(lowerGrid, "buy")) {
-                    orderManager.addOrder("buy", currentPrice, lowerGrid);
+// 處理一次價格更新：更新網格，並對前後兩次價格之間觸及的所有網格線下單
+// price_trigger 為 "touch" 且有盤口時，買入以賣一價觸發、賣出以買一價觸發
+GridTickResult onPriceUpdate(StrategyState& state, const StrategyConfig& config, const PriceUpdate& update) {
+    GridOrderManager& orderManager = state.orderManager;
+    VolatilityEstimator& volatility = state.volatility;
+    const DecimalScale& scale = orderManager.getScale();
+    const GridGeometry& geometry = orderManager.getGeometry();
+    const int GRID_COUNT = config.gridCount;
+    double gridSpacing = config.configuredGridSpacing();
+    double triggerThreshold = config.orderTriggerThreshold;
+    double currentPrice = update.price;
+    
+    // 先套用訂單閘道送回的回報，被拒絕的網格線可在本次行情重新下單
+    orderManager.processReplies();
+    
+    long long timeMs = update.eventTime > 0
+        ? update.eventTime
+        : std::chrono::duration_cast<std::chrono::milliseconds>(
+              std::chrono::system_clock::now().time_since_epoch()).count();
+    volatility.onTick(currentPrice, timeMs);
+    
+    // 動態網格間距；等比網格換算為相對當前價格的比例
+    if (config.dynamicGridSpacing && volatility.isReady()) {
+        gridSpacing = calculateDynamicGridSpacing(
+            volatility.priceVolatility(),
+            config.volatilitySpacingMultiplier,
+            config.minGridSpacing);
+        if (geometry.getMode() == GridGeometry::Mode::Geometric) {
+            gridSpacing /= currentPrice;
+        }
+    }
+    orderManager.setGridSpacing(gridSpacing, currentPrice);
+    
+    bool useTouch = config.priceTrigger == PriceTrigger::Touch
+                    && update.bidPrice > 0 && update.askPrice > 0;
+    double buyPrice = useTouch ? update.askPrice : currentPrice;
+    double sellPrice = useTouch ? update.bidPrice : currentPrice;
+    
+    // 網格窗口以基準網格為中心；有限網格只在價格上下限內交易
+    long long baseIndex = geometry.indexOf(currentPrice);
+    long long minIndex = baseIndex - GRID_COUNT;
+    long long maxIndex = baseIndex + GRID_COUNT;
+    double baseGrid = scale.toDouble(orderManager.levelPrice(baseIndex));
+    
+    // 更新訂單管理系統：網格窗口隨基準網格平移
+    orderManager.updateGridWindow(minIndex, maxIndex);
+    if (geometry.isBounded()) {
+        minIndex = std::max(minIndex, geometry.minLevel());
+        maxIndex = std::min(maxIndex, geometry.maxLevel());
+    }
+    
+    // 一次算出本次穿越的所有網格線並批量下單
+    state.crossDetector.detect(buyPrice, sellPrice, geometry, triggerThreshold,
+                               minIndex, maxIndex, state.crosses);
+    if (state.crosses.size() > 1) {
+        state.console << "Price crossed " << state.crosses.size() << " grid levels" << std::endl;
+    }
+    for (const GridCross& cross : state.crosses) {
+        Price level = orderManager.levelPrice(cross.levelIndex);
+        OrderSide side = cross.isBuy ? OrderSide::Buy : OrderSide::Sell;
+        if (orderManager.shouldPlaceOrderAtGrid(level, side)) {
+            orderManager.addOrder(side, scale.toPrice(cross.isBuy ? buyPrice : sellPrice), level);
+        }
+    }
+    
+    // 最近的未觸發網格線：下方尚無買單或上方尚無賣單、且價格尚未進入其觸發區
+    // 觸發區邊界位於座標 k ± triggerThreshold
+    double nearestLevelDistance = std::numeric_limits<double>::infinity();
+    for (long long k = static_cast<long long>(std::ceil(geometry.coordinate(buyPrice) - triggerThreshold)) - 1;
+         k >= minIndex; k--) {
+        if (orderManager.shouldPlaceOrderAtGrid(orderManager.levelPrice(k), OrderSide::Buy)) {
+            nearestLevelDistance = buyPrice - geometry.priceAt(k + triggerThreshold);
+            break;
+        }
+    }
+    for (long long k = static_cast<long long>(std::floor(geometry.coordinate(sellPrice) + triggerThreshold)) + 1;
+         k <= maxIndex; k++) {
+        if (orderManager.shouldPlaceOrderAtGrid(orderManager.levelPrice(k), OrderSide::Sell)) {
+            nearestLevelDistance = std::min(nearestLevelDistance, geometry.priceAt(k - triggerThreshold) - sellPrice);
+            break;
+        }
+    }
+    
+    return GridTickResult{baseGrid, geometry.getSpacing(), std::max(0.0, nearestLevelDistance)};
+}
+
+// 打印當前狀態與交易統計；多個執行緒共用輸出時整塊輸出期間加鎖
+void printStatus(StrategyState& state, double currentPrice, double baseGrid) {
+    PairConsole::Block block(state.console);
+    const GridOrderManager& orderManager = state.orderManager;
+    const VolatilityEstimator& volatility = state.volatility;
+    std::ostream& console = state.console;
+    console << "\nCurrent price: " << currentPrice << std::endl;
+    console << "Base grid: " << baseGrid << std::endl;
+    if (volatility.isReady()) {
+        console << "Volatility: " << volatility.priceVolatility()
+                << " (ATR: " << volatility.averageTrueRange()
+                << ", EWMA: " << volatility.ewmaVolatility() << ")" << std::endl;
+    }
+    orderManager.printActiveOrders();
+    orderManager.printTradingStats(orderManager.getScale().toPrice(currentPrice));
+    if (state.conflatedEvents > 0) {
+        console << "Market data conflated: " << state.conflatedEvents << " event(s)" << std::endl;
+    }
+}
+
+// 發布該交易對的最新統計，供彙總報告讀取
+void publishStats(StrategyState& state, double currentPrice) {
+    const GridOrderManager& orderManager = state.orderManager;
+    const DecimalScale& scale = orderManager.getScale();
+    const PnlLedger& ledger = orderManager.getPnlLedger();
+    state.ticks++;
+    state.stats.publish(PairStats{
+        state.ticks,
+        orderManager.activeOrderCount(),
+        ledger.tradeCount(),
+        ledger.winningTrades(),
+        currentPrice,
+        scale.toDouble(orderManager.getPosition().quantity),
+        scale.toDouble(ledger.total())});
+}
+
+// 輪詢模式下處理一個交易對的價格，回傳下一次取價前應等待的毫秒數
+// 開啟 adaptive_polling 時按距網格線遠近調整間隔
+long long gridTrading(StrategyState& state, const StrategyConfig& config, const PriceUpdate& update) {
+    GridTickResult tick = onPriceUpdate(state, config, update);
+    publishStats(state, update.price);
+    printStatus(state, update.price, tick.baseGrid);
+    
+    if (!config.adaptivePolling) {
+        // 使用配置的更新間隔
+        return config.updateIntervalSeconds * 1000;
+    }
+    
+    long long waitMs = state.scheduler.onPoll(
+        tick.nearestLevelDistance,
+        state.volatility.isReady() ? state.volatility.priceVolatility() : 0,
+        state.volatility.getIntervalMs());
+    state.console << "Poll rate: " << state.scheduler.pollsPerMinute() << "/min"
+                  << " (next poll in " << waitMs << " ms, nearest level "
+                  << tick.nearestLevelDistance << " away)" << std::endl;
+    return waitMs;
+}
+
+/**
+ * @brief 多交易對引擎：每個交易對一個策略狀態，由固定數量的工作執行緒分片處理
+ *
+ * engine_mode 為 "pooled"（預設）時，第 i 個交易對由第 i mod N 個工作執行緒處理。
+ * 主執行緒專責取得行情：串流模式下只建立一條 WebSocket 連線，輪詢模式下每輪以一次批量請求取得所有價格，
+ * 標準化的價格事件經 PriceChannel 交給工作執行緒，慢速的網路回應不會延遲下單邏輯；
+ * 工作執行緒落後時每批只處理每個交易對最新的行情（market_data_conflation）。
+ * 為 "sharded" 時，交易對按名稱雜湊分配到 N 個分片，每個分片一條綁定CPU核心的執行緒，
+ * 擁有自己的行情連線、訂單ID生成器與輸出文件，行情路徑上沒有鎖或共享的可變狀態；
+ * 各交易對的統計經順序鎖槽位發布，只在主執行緒的彙總報告中讀取合併。
+ * 分片內的取價與決策在同一執行緒上進行，不經過通道。
+ * 兩種模式下同一交易對的行情都在同一執行緒上串行決策，策略狀態不需要加鎖。
+ * 下單與撤單經無鎖佇列交給訂單閘道執行緒非同步送出，回報經各策略的回報佇列送回：
+ * pooled 模式下所有策略共用一個閘道，sharded 模式下每個分片有自己的閘道（live 模式下連同交易所客戶端），
+ * 分片之間在下單路徑上同樣不共享可變狀態。
+ * execution_mode 為 "live" 時閘道經簽名的 REST 客戶端向交易所下單，否則以模擬撮合回應。
+ */
+class GridEngine {
+private:
+    // 一個工作執行緒負責的交易對與其獨佔的資源
+    struct Shard {
+        std::vector<StrategyState*> strategies;
+        std::unique_ptr<OrderIdGenerator> orderIds;  // 分片模式下各分片獨立
+        std::unique_ptr<std::ofstream> log;          // 分片模式下的輸出文件
+    };
+    
+    // 一個訂單閘道與其 live 模式下的傳輸層
+    // 客戶端宣告在閘道之前：解構時閘道先停止並等待閘道執行緒，之後才釋放客戶端
+    struct OrderRoute {
+        std::unique_ptr<BinanceOrderClient> client;  // 只在閘道執行緒上使用
+        std::unique_ptr<OrderGateway> gateway;       // 沒有交易對的分片為空
+        std::vector<size_t> pairs;                   // 閘道回報佇列編號 -> 配置 pairs 下標
+    };
+    
+    const ConfigWatcher& configWatcher;
+    EngineMode mode;
+    OrderIdGenerator sharedOrderIds;  // pooled 模式下所有交易對共用
+    std::vector<OrderRoute> orderRoutes;  // pooled 模式下所有交易對共用一個，sharded 模式下每個分片一個
+    std::mutex consoleMutex;          // pooled 模式下共用終端的輸出鎖
+    std::vector<std::unique_ptr<StrategyState>> strategies;  // 與配置 pairs 同序
+    std::unordered_map<std::string, size_t> pairIndex;       // 交易對 -> strategies 下標
+    std::vector<Shard> shards;                                // 工作執行緒 -> 負責的策略
+    std::vector<std::unique_ptr<PriceChannel>> channels;     // pooled 模式下行情執行緒到各工作執行緒的通道
+    std::vector<uint64_t> eventSequences;                    // 交易對 -> 已發布的事件序號（只由行情執行緒使用）
+    std::vector<std::thread> workers;
+    
+    static constexpr size_t MAX_EVENT_BATCH = 256;
+    
+public:
+    explicit GridEngine(const ConfigWatcher& watcher)
+        : configWatcher(watcher) {
+        const EngineConfig& config = *watcher.snapshot();
+        mode = config.engineMode;
+        
+        size_t shardCount = config.workerThreads > 0
+            ? config.workerThreads
+            : std::max<size_t>(1, std::thread::hardware_concurrency());
+        if (mode == EngineMode::Pooled) {
+            shardCount = std::min(shardCount, config.pairs.size());
+        }
+        shards.resize(shardCount);
+        
+        if (mode == EngineMode::Sharded) {
+            std::filesystem::create_directories(config.shardLogDir);
+            for (size_t k = 0; k < shardCount; k++) {
+                std::string path = (std::filesystem::path(config.shardLogDir) /
+                                    ("shard-" + std::to_string(k) + ".log")).string();
+                shards[k].orderIds = std::make_unique<OrderIdGenerator>();
+                shards[k].log = std::make_unique<std::ofstream>(path, std::ios::app);
+                if (!shards[k].log->is_open()) {
+                    throw std::runtime_error("Failed to open shard log: " + path);
                 }
             }
-            // 檢查是否需要在上方網格線賣出
-            else if (std::abs(currentPrice - upperGrid) < gridSpacing * 0.1) {
-                if (orderManager.shouldPlaceOrderAtGrid(upperGrid, "sell")) {
-                    orderManager.addOrder("sell", currentPrice, upperGrid);
+        }
+        
+        // 先決定每個交易對所屬的分片與訂單閘道，再按各閘道的交易對數建立閘道
+        std::vector<size_t> shardOf(config.pairs.size());
+        std::vector<size_t> routeOf(config.pairs.size());
+        std::vector<uint32_t> slotOf(config.pairs.size());
+        orderRoutes.resize(mode == EngineMode::Sharded ? shardCount : 1);
+        for (size_t i = 0; i < config.pairs.size(); i++) {
+            shardOf[i] = mode == EngineMode::Sharded
+                ? symbolHash(config.pairs[i].tradingPair) % shardCount
+                : i % shardCount;
+            routeOf[i] = mode == EngineMode::Sharded ? shardOf[i] : 0;
+            slotOf[i] = static_cast<uint32_t>(orderRoutes[routeOf[i]].pairs.size());
+            orderRoutes[routeOf[i]].pairs.push_back(i);
+        }
+        for (OrderRoute& route : orderRoutes) {
+            if (!route.pairs.empty()) {
+                route.gateway = std::make_unique<OrderGateway>(config.orderQueueCapacity, route.pairs.size());
+            }
+        }
+        
+        for (size_t i = 0; i < config.pairs.size(); i++) {
+            const StrategyConfig& pair = config.pairs[i];
+            Shard& shard = shards[shardOf[i]];
+            OrderGateway& gateway = *orderRoutes[routeOf[i]].gateway;
+            if (mode == EngineMode::Sharded) {
+                strategies.push_back(std::make_unique<StrategyState>(pair, i, *shard.orderIds, gateway, slotOf[i],
+                                                                      *shard.log, nullptr));
+            } else {
+                strategies.push_back(std::make_unique<StrategyState>(pair, i, sharedOrderIds, gateway, slotOf[i],
+                                                                      std::cout, &consoleMutex));
+            }
+            shard.strategies.push_back(strategies.back().get());
+            pairIndex.emplace(pair.tradingPair, i);
+        }
+        
+        if (config.executionMode == ExecutionMode::Live) {
+            connectExchange(config);
+        }
+        
+        std::cout << "Trading " << strategies.size() << " pair(s) on " << shardCount
+                  << (mode == EngineMode::Sharded ? " pinned shard(s)" : " worker thread(s)") << std::endl;
+    }
+    
+    // 啟動前回補歷史K線，讓波動率指標立即可用
+    // K線週期、回補根數、快取目錄與並行數都相同的交易對合併為一次批量回補，各交易對的覆寫因此都會生效
+    void backfillKlines() {
+        using BackfillKey = std::tuple<std::string, size_t, std::string, size_t>;
+        std::map<BackfillKey, std::vector<StrategyState*>> groups;
+        for (const auto& state : strategies) {
+            const StrategyConfig& config = *state->activeConfig;
+            if (config.klineBackfill) {
+                groups[BackfillKey(config.volatilityKlineInterval, config.klineBackfillBars, config.klineCacheDir,
+                                   config.klineBackfillConcurrency)].push_back(state.get());
+            }
+        }
+        
+        for (const auto& [key, group] : groups) {
+            const StrategyConfig& config = *group.front()->activeConfig;
+            const std::string& interval = std::get<0>(key);
+            std::vector<std::string> symbols;
+            for (const StrategyState* state : group) {
+                symbols.push_back(state->activeConfig->tradingPair);
+            }
+            try {
+                KlineBackfill backfill(
+                    config.restBaseUrl,
+                    interval,
+                    config.klineBackfillBars,
+                    config.klineCacheDir,
+                    config.klineBackfillConcurrency);
+                auto history = backfill.run(symbols);
+                for (StrategyState* state : group) {
+                    for (const auto& bar : history[state->activeConfig->tradingPair]) {
+                        state->volatility.addKline(bar);
+                    }
                 }
+            } catch (const std::exception& error) {
+                std::cerr << "Kline backfill failed: " << error.what() << std::endl;
             }
         }
     }
     
-    // 打印當前狀態
-    std::cout << "\nCurrent price: " << currentPrice << std::endl;
-    std::cout << "Base grid: " << baseGrid << std::endl;
-    orderManager.printActiveOrders();
+    // 啟動工作執行緒並阻塞執行；pooled 串流模式下呼叫執行緒負責接收行情，sharded 模式下負責彙總報告
+    void run() {
+        const StrategyConfig& config = *strategies.front()->activeConfig;
+        bool streaming = config.marketDataMode == MarketDataMode::Stream;
+        if (streaming) {
+            std::cout << "Market data mode: stream" << std::endl;
+        }
+        for (OrderRoute& route : orderRoutes) {
+            if (route.gateway) {
+                route.gateway->start();
+            }
+        }
+        
+        if (mode == EngineMode::Sharded) {
+            for (size_t shard = 0; shard < shards.size(); shard++) {
+                if (shards[shard].strategies.empty()) continue;
+                workers.emplace_back([this, shard, streaming]() {
+                    pinCurrentThread(shard);
+                    if (streaming) {
+                        shardStream(shard);
+                    } else {
+                        shardPoll(shard);
+                    }
+                });
+            }
+            reportLoop();
+        } else {
+            const EngineConfig& engineConfig = *configWatcher.snapshot();
+            eventSequences.assign(strategies.size(), 0);
+            for (size_t worker = 0; worker < shards.size(); worker++) {
+                channels.push_back(std::make_unique<PriceChannel>(
+                    engineConfig.priceRingCapacity, strategies.size(), engineConfig.marketDataConflation));
+            }
+            for (size_t worker = 0; worker < shards.size(); worker++) {
+                workers.emplace_back([this, worker, streaming]() { channelWorker(worker, streaming); });
+            }
+            if (streaming) {
+                std::vector<std::string> symbols;
+                for (const auto& state : strategies) {
+                    symbols.push_back(state->activeConfig->tradingPair);
+                }
+                runStream(config, symbols, [this](const PriceUpdate& update) { dispatch(update); });
+            } else {
+                pollFeed(config);
+            }
+        }
+        
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
     
-    // 在循環結束時添加統計信息打印
-    orderManager.printTradingStats(currentPrice);
+private:
+    // live 模式：為每個訂單閘道建立簽名的訂單客戶端並校時，作為該閘道的傳輸層，並開啟掛單狀態輪詢
+    void connectExchange(const EngineConfig& config) {
+        for (OrderRoute& route : orderRoutes) {
+            if (!route.gateway) continue;
+            route.client = std::make_unique<BinanceOrderClient>(
+                config.pairs.front().restBaseUrl,
+                config.apiKey,
+                config.apiSecret,
+                config.recvWindowMs);
+            for (size_t i : route.pairs) {
+                route.client->addMarket(config.pairs[i].tradingPair, config.pairs[i].scale);
+            }
+            route.client->syncClock();
+            std::cout << "Live order entry: " << config.pairs.front().restBaseUrl << " for " << route.pairs.size()
+                      << " pair(s) (clock offset " << route.client->getClockOffsetMs() << " ms)" << std::endl;
+            
+            BinanceOrderClient* client = route.client.get();
+            OrderGateway* gateway = route.gateway.get();
+            client->setReplyHandler([gateway](const OrderReply& reply) { gateway->onResponse(reply); });
+            gateway->setTransport(
+                [client](const OrderRequest& request) { client->send(request); },
+                [client]() { return client->poll(); });
+            gateway->setStatusPolling(std::chrono::milliseconds(config.orderStatusPollMs));
+        }
+    }
     
-    // 使用配置的更新間隔
-    std::this_thread::sleep_for(
-        std::chrono::seconds(config["update_interval_seconds"]));
-}
+    // 交易對名稱的 FNV-1a 雜湊，分片分配在不同平台與重啟之間保持穩定
+    static uint64_t symbolHash(const std::string& symbol) {
+        uint64_t hash = 14695981039346656037ULL;
+        for (unsigned char c : symbol) {
+            hash = (hash ^ c) * 1099511628211ULL;
+        }
+        return hash;
+    }
+    
+    // 將當前執行緒綁定到第 shard 個可用的CPU核心（僅 Linux）
+    static void pinCurrentThread(size_t shard) {
+#ifdef __linux__
+        cpu_set_t allowed;
+        CPU_ZERO(&allowed);
+        if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0 || CPU_COUNT(&allowed) == 0) return;
+        
+        int target = static_cast<int>(shard % static_cast<size_t>(CPU_COUNT(&allowed)));
+        for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+            if (!CPU_ISSET(cpu, &allowed) || target-- > 0) continue;
+            cpu_set_t pinned;
+            CPU_ZERO(&pinned);
+            CPU_SET(cpu, &pinned);
+            int error = pthread_setaffinity_np(pthread_self(), sizeof(pinned), &pinned);
+            if (error != 0) {
+                std::cerr << "Failed to pin shard " << shard << " to CPU " << cpu
+                          << ": " << std::strerror(error) << std::endl;
+            }
+            return;
+        }
+#else
+        (void)shard;
+#endif
+    }
+    
+    // sharded 輪詢模式：每輪以一次批量請求取得分片內所有交易對的價格，逐一決策後休眠到最早需要取價的時間
+    void shardPoll(size_t shardIndex) {
+        const std::vector<StrategyState*>& shard = shards[shardIndex].strategies;
+        MarketDataClient marketData(shard.front()->activeConfig->restBaseUrl);
+        marketData.warmUp();
+        std::vector<std::string> symbols;
+        for (const StrategyState* state : shard) {
+            symbols.push_back(state->activeConfig->tradingPair);
+        }
+        TickerBatch batch(symbols);
+        PriceUpdate update;
+        
+        while (true) {
+            long long waitMs = std::numeric_limits<long long>::max();
+            try {
+                marketData.getCurrentPrices(batch);
+            } catch (const std::runtime_error& error) {
+                std::cerr << "Error: " << error.what() << std::endl;
+                batch.reset();
+            }
+            
+            for (size_t i = 0; i < shard.size(); i++) {
+                StrategyState& state = *shard[i];
+                const StrategyConfig& config = refreshConfig(state, configWatcher);
+                double price = batch.priceAt(i);
+                if (std::isnan(price)) {
+                    waitMs = std::min(waitMs, config.minPollIntervalMs);
+                    continue;
+                }
+                update.price = price;
+                try {
+                    waitMs = std::min(waitMs, gridTrading(state, config, update));
+                } catch (const std::runtime_error& error) {
+                    std::cerr << "Error: " << error.what() << std::endl;
+                    waitMs = std::min(waitMs, config.minPollIntervalMs);
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(waitMs));
+        }
+    }
+    
+    // 處理一筆推送行情，狀態按該交易對的更新間隔打印
+    void processUpdate(StrategyState& state, const PriceUpdate& update) {
+        try {
+            const StrategyConfig& config = refreshConfig(state, configWatcher);
+            GridTickResult tick = onPriceUpdate(state, config, update);
+            publishStats(state, update.price);
+            auto now = std::chrono::steady_clock::now();
+            if (now - state.lastReport >= std::chrono::seconds(config.updateIntervalSeconds)) {
+                printStatus(state, update.price, tick.baseGrid);
+                state.lastReport = now;
+            }
+        } catch (const std::runtime_error& error) {
+            std::cerr << "Error: " << error.what() << std::endl;
+        }
+    }
+    
+    // 輪詢模式下處理一筆價格並記錄該交易對要求的下一次取價時間
+    void processPoll(StrategyState& state, const PriceUpdate& update) {
+        const StrategyConfig& config = refreshConfig(state, configWatcher);
+        long long waitMs = config.minPollIntervalMs;
+        try {
+            waitMs = gridTrading(state, config, update);
+        } catch (const std::runtime_error& error) {
+            std::cerr << "Error: " << error.what() << std::endl;
+        }
+        state.nextPollMs.store(steadyMs() + waitMs, std::memory_order_relaxed);
+    }
+    
+    // pooled 模式的工作執行緒：從通道批量取出價格事件逐筆決策，沒有事件時退避等待
+    void channelWorker(size_t worker, bool streaming) {
+        PriceChannel& channel = *channels[worker];
+        std::vector<PriceEvent> batch;
+        batch.reserve(MAX_EVENT_BATCH);
+        IdleBackoff backoff(streaming ? std::chrono::microseconds(50) : std::chrono::microseconds(1000));
+        PriceUpdate update;
+        
+        while (true) {
+            if (channel.consume(batch, MAX_EVENT_BATCH) == 0) {
+                backoff.idle();
+                continue;
+            }
+            backoff.reset();
+            for (const PriceEvent& event : batch) {
+                strategies[event.pair]->conflatedEvents = channel.conflatedCount(event.pair);
+                update.price = event.price;
+                update.bidPrice = event.bidPrice;
+                update.askPrice = event.askPrice;
+                update.eventTime = event.eventTime;
+                if (streaming) {
+                    processUpdate(*strategies[event.pair], update);
+                } else {
+                    processPoll(*strategies[event.pair], update);
+                }
+            }
+        }
+    }
+    
+    // 行情執行緒：把價格標準化為事件，發布到負責該交易對的工作執行緒
+    void publish(size_t pair, double price, double bidPrice, double askPrice, long long eventTime) {
+        PriceEvent event{static_cast<uint32_t>(pair), ++eventSequences[pair], price, bidPrice, askPrice, eventTime};
+        channels[pair % shards.size()]->publish(event);
+    }
+    
+    // 串流行情的分派，忽略未配置的交易對
+    void dispatch(const PriceUpdate& update) {
+        auto it = pairIndex.find(update.symbol);
+        if (it == pairIndex.end()) return;
+        publish(it->second, update.price, update.bidPrice, update.askPrice, update.eventTime);
+    }
+    
+    static long long steadyMs() {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+    
+    // pooled 輪詢模式的行情執行緒：每輪以一次批量請求取得所有交易對的價格並發布
+    // 下一輪在各交易對要求的最早時間進行，兩輪之間至少間隔 min_poll_interval_ms；
+    // 工作執行緒尚未處理完上一輪時，每隔最小間隔重新檢查一次要求的時間
+    void pollFeed(const StrategyConfig& config) {
+        MarketDataClient marketData(config.restBaseUrl);
+        marketData.warmUp();
+        std::vector<std::string> symbols;
+        for (const auto& state : strategies) {
+            symbols.push_back(state->activeConfig->tradingPair);
+        }
+        TickerBatch batch(symbols);
+        
+        while (true) {
+            long long fetchedAt = steadyMs();
+            try {
+                marketData.getCurrentPrices(batch);
+            } catch (const std::runtime_error& error) {
+                std::cerr << "Error: " << error.what() << std::endl;
+                batch.reset();
+            }
+            for (size_t i = 0; i < batch.size(); i++) {
+                if (!std::isnan(batch.priceAt(i))) {
+                    publish(i, batch.priceAt(i), 0, 0, 0);
+                }
+            }
+            
+            long long minGapMs = std::numeric_limits<long long>::max();
+            for (const StrategyConfig& pair : configWatcher.snapshot()->pairs) {
+                minGapMs = std::min(minGapMs, pair.minPollIntervalMs);
+            }
+            while (true) {
+                long long requested = std::numeric_limits<long long>::max();
+                for (const auto& state : strategies) {
+                    requested = std::min(requested, state->nextPollMs.load(std::memory_order_relaxed));
+                }
+                long long now = steadyMs();
+                long long due = std::max(fetchedAt + minGapMs, requested);
+                if (now >= due) break;
+                std::this_thread::sleep_for(std::chrono::milliseconds(std::min(due - now, minGapMs)));
+            }
+        }
+    }
+    
+    // sharded 串流模式：分片自己的連線只訂閱本分片的交易對，收到行情直接在本執行緒決策
+    void shardStream(size_t shardIndex) {
+        const std::vector<StrategyState*>& shard = shards[shardIndex].strategies;
+        std::unordered_map<std::string, StrategyState*> bySymbol;
+        std::vector<std::string> symbols;
+        for (StrategyState* state : shard) {
+            bySymbol.emplace(state->activeConfig->tradingPair, state);
+            symbols.push_back(state->activeConfig->tradingPair);
+        }
+        runStream(*shard.front()->activeConfig, symbols, [&](const PriceUpdate& update) {
+            auto it = bySymbol.find(update.symbol);
+            if (it != bySymbol.end()) {
+                processUpdate(*it->second, update);
+            }
+        });
+    }
+    
+    // 建立一條串流連線訂閱 symbols 並阻塞接收
+    // stream_type 為 "depth" 時在本地維護各交易對的L2訂單簿，盤口變動即回調
+    // 連線相關的鍵不可熱重載，使用啟動時的配置
+    static void runStream(const StrategyConfig& config, const std::vector<std::string>& symbols,
+                          const PriceStream::UpdateHandler& handleUpdate) {
+        PriceStream stream(config.wsBaseUrl, config.streamType);
+        for (const std::string& symbol : symbols) {
+            stream.subscribe(symbol);
+        }
+        if (config.streamType != "depth") {
+            stream.run(handleUpdate);
+            return;
+        }
+        
+        MarketDataClient rest(config.restBaseUrl);
+        OrderBookFeed books(rest, handleUpdate, config.depthSnapshotLimit);
+        for (const std::string& symbol : symbols) {
+            books.addSymbol(symbol);
+        }
+        stream.onConnect([&]() { books.onReconnect(); });
+        stream.onDepth([&](const json& depthUpdate) {
+            try {
+                books.onDepthUpdate(depthUpdate);
+            } catch (const std::runtime_error& error) {
+                std::cerr << "Order book error: " << error.what() << std::endl;
+            }
+        });
+        stream.run(handleUpdate);
+    }
+    
+    // sharded 模式的彙總報告：只在這裡讀取各交易對發布的統計並合併，不影響行情路徑
+    // 盈虧直接相加，假設所有交易對以同一種貨幣報價
+    void reportLoop() {
+        while (true) {
+            long long intervalSeconds = configWatcher.snapshot()->pairs.front().updateIntervalSeconds;
+            std::this_thread::sleep_for(std::chrono::seconds(std::max(1LL, intervalSeconds)));
+            
+            uint64_t totalTicks = 0, totalOpen = 0, totalTrades = 0, totalWinners = 0;
+            double totalPnl = 0;
+            std::cout << "\n=== Engine Summary ===" << std::endl;
+            for (size_t k = 0; k < shards.size(); k++) {
+                if (shards[k].strategies.empty()) continue;
+                uint64_t ticks = 0, openOrders = 0;
+                double realizedPnl = 0;
+                for (const StrategyState* state : shards[k].strategies) {
+                    PairStats stats = state->stats.read();
+                    ticks += stats.ticks;
+                    openOrders += stats.openOrders;
+                    realizedPnl += stats.realizedPnl;
+                    totalTrades += stats.closedTrades;
+                    totalWinners += stats.winningTrades;
+                }
+                std::cout << "Shard " << k << ": " << shards[k].strategies.size() << " pair(s), "
+                          << ticks << " ticks, " << openOrders << " open orders, realized P&L "
+                          << realizedPnl << std::endl;
+                totalTicks += ticks;
+                totalOpen += openOrders;
+                totalPnl += realizedPnl;
+            }
+            std::cout << "Total: " << strategies.size() << " pair(s), " << totalTicks << " ticks, "
+                      << totalOpen << " open orders, " << totalTrades << " closed trades ("
+                      << totalWinners << " winning), realized P&L " << totalPnl << std::endl;
+        }
+    }
+};
 
 int main() {
     std::cout << "Reading configuration file..." << std::endl;
     std::ifstream configFile("config.json");
-    json config;
-    configFile >> config;
+    EngineConfig config;
+    try {
+        json configJson;
+        configFile >> configJson;
+        config = EngineConfig::fromJson(configJson);
+    } catch (const std::exception& error) {
+        std::cerr << "Failed to load configuration: " << error.what() << std::endl;
+        return 1;
+    }
 
-    std::cout << "Configuration loaded. Starting trading for " 
-              << config["trading_pair"] << "..." << std::endl;
-    std::cout << "Grid mode: " 
-              << (config["infinite_grid"] ? "Infinite" : "Limited") << std::endl;
+    for (const StrategyConfig& pair : config.pairs) {
+        std::cout << "Configuration loaded. Starting trading for " 
+                  << pair.tradingPair << "..." << std::endl;
+        std::cout << "Grid mode: " 
+                  << (pair.infiniteGrid ? "Infinite" : "Limited") << std::endl;
+    }
 
-    while (true) {
-        try {
-            gridTrading(config);
-        } catch (const std::runtime_error& error) {
-            std::cerr << "Error: " << error.what() << std::endl;
-        }
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+    
+    // 監視配置文件，修改後於下一次行情套用
+    ConfigWatcher configWatcher("config.json", config);
+    configWatcher.start();
+    std::unique_ptr<GridEngine> engine;
+    try {
+        engine = std::make_unique<GridEngine>(configWatcher);
+    } catch (const std::exception& error) {
+        std::cerr << "Failed to start engine: " << error.what() << std::endl;
+        return 1;
     }
+    engine->backfillKlines();
+    engine->run();
 
+    curl_global_cleanup();
     return 0;
 }
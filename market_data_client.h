@@ -0,0 +1,217 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "async_http_client.h"
+#include "ticker_parser.h"
+
+/**
+ * @brief 批量取價的交易對表
+ *
+ * 交易對在建構時固定，查詢路徑與價格陣列只在此處分配一次，
+ * 之後每輪取價只覆寫 prices，成本不隨交易對數量增長。
+ * 交易對列表超過URL長度上限時切成多段查詢，由 MarketDataClient 並行請求。
+ */
+class TickerBatch {
+private:
+    std::vector<std::string> symbols;
+    std::unordered_map<std::string, size_t> index;  // 交易對 -> 陣列下標
+    std::vector<double> prices;                      // 與 symbols 同序
+    std::vector<std::string> paths;                  // 預先組好的請求路徑，每段一個
+    std::string keyBuffer;                           // 查表用的重用鍵緩衝區
+
+    // 單段查詢字串的長度上限，避免URL過長
+    static constexpr size_t MAX_QUERY_LENGTH = 2000;
+
+public:
+    explicit TickerBatch(const std::vector<std::string>& syms)
+        : symbols(syms)
+        , prices(syms.size(), std::numeric_limits<double>::quiet_NaN()) {
+        index.reserve(symbols.size());
+        for (size_t i = 0; i < symbols.size(); i++) {
+            index.emplace(symbols[i], i);
+        }
+
+        // symbols=["ETHUSDT","BTCUSDT"]（URL編碼），超過長度上限時另起一段
+        std::string query;
+        for (size_t i = 0; i < symbols.size(); i++) {
+            std::string quoted = "%22" + symbols[i] + "%22";
+            if (!query.empty() && query.size() + 3 + quoted.size() + 3 > MAX_QUERY_LENGTH) {
+                paths.push_back("/api/v3/ticker/price?symbols=%5B" + query + "%5D");
+                query.clear();
+            }
+            if (!query.empty()) query += "%2C";
+            query += quoted;
+        }
+        if (!query.empty()) {
+            paths.push_back("/api/v3/ticker/price?symbols=%5B" + query + "%5D");
+        }
+    }
+
+    size_t size() const { return symbols.size(); }
+    const std::string& symbolAt(size_t i) const { return symbols[i]; }
+    double priceAt(size_t i) const { return prices[i]; }
+    const std::vector<std::string>& requestPaths() const { return paths; }
+
+    // 查找交易對下標，不存在時回傳 size()
+    size_t indexOf(const std::string& symbol) const {
+        auto it = index.find(symbol);
+        return it == index.end() ? symbols.size() : it->second;
+    }
+
+    // 寫入價格，忽略不在表中的交易對（全市場查詢時會收到）
+    bool setPrice(std::string_view symbol, double price) {
+        keyBuffer.assign(symbol.data(), symbol.size());
+        auto it = index.find(keyBuffer);
+        if (it == index.end()) return false;
+        prices[it->second] = price;
+        return true;
+    }
+
+    // 將所有價格標記為未知
+    void reset() {
+        std::fill(prices.begin(), prices.end(), std::numeric_limits<double>::quiet_NaN());
+    }
+};
+
+/**
+ * @brief 行情客戶端，在整個程式生命週期內重用同一組連線
+ *
+ * 請求經 AsyncHttpClient 送出：分段的批量取價同時進行，一輪取價的耗時約為單次往返，
+ * 不隨分段數增長。每個方法都等到所有請求完成才返回。
+ */
+class MarketDataClient {
+private:
+    AsyncHttpClient http;
+    std::string baseUrl;
+    std::string path;            // 重用的請求路徑緩衝區
+    std::string responseBuffer;  // 重用的回應緩衝區
+
+public:
+    explicit MarketDataClient(const std::string& base)
+        : http(base)
+        , baseUrl(base) {
+        path.reserve(64);
+        responseBuffer.reserve(4096);
+    }
+
+    /**
+     * @brief 啟動時預熱連線，讓第一次取價不必承擔握手延遲
+     */
+    void warmUp() {
+        try {
+            get("/api/v3/ping");
+            std::cout << "Market data connection warmed up: " << baseUrl << std::endl;
+        } catch (const std::runtime_error&) {
+            std::cerr << "Market data warm-up failed, will retry on first request" << std::endl;
+        }
+    }
+
+    /**
+     * @brief 取得一批交易對的當前價格，各段查詢並行請求
+     * @param batch 交易對表，價格直接寫入其預分配陣列
+     * @return 成功取得價格的交易對數量，缺失者保持為NaN
+     * @throws std::runtime_error 任一段請求失敗或回應無法解析時，在所有請求完成後拋出；其餘段的價格仍已寫入
+     */
+    size_t getCurrentPrices(TickerBatch& batch) {
+        batch.reset();
+        std::string error;
+        for (const std::string& pathAndQuery : batch.requestPaths()) {
+            http.submit(HttpMethod::Get, pathAndQuery, [&batch, &error](const HttpResponse& response) {
+                try {
+                    if (!response.ok()) {
+                        throw std::runtime_error(response.errorMessage());
+                    }
+                    parsePrices(response.body, batch);
+                } catch (const std::runtime_error& e) {
+                    if (error.empty()) error = e.what();
+                }
+            });
+        }
+        http.drain();
+        if (!error.empty()) {
+            throw std::runtime_error(error);
+        }
+
+        size_t filled = 0;
+        for (size_t i = 0; i < batch.size(); i++) {
+            if (!std::isnan(batch.priceAt(i))) filled++;
+        }
+        return filled;
+    }
+
+    /**
+     * @brief 取得訂單簿深度快照
+     * @param symbol 交易對名稱
+     * @param limit 檔位數量（5/10/20/50/100/500/1000/5000）
+     */
+    nlohmann::json getDepthSnapshot(const std::string& symbol, int limit) {
+        path.assign("/api/v3/depth?symbol=").append(symbol)
+            .append("&limit=").append(std::to_string(limit));
+        const std::string& readBuffer = get(path);
+
+        try {
+            return nlohmann::json::parse(readBuffer);
+        } catch (const nlohmann::json::exception& e) {
+            throw std::runtime_error("JSON parse error: " + std::string(e.what()));
+        }
+    }
+
+private:
+    // 發送單一GET請求並等待完成，回應指向內部緩衝區，下次請求前有效
+    const std::string& get(const std::string& pathAndQuery) {
+        responseBuffer.clear();
+        std::string error;
+        http.submit(HttpMethod::Get, pathAndQuery, [this, &error](const HttpResponse& response) {
+            if (response.ok()) {
+                responseBuffer.assign(response.body);
+            } else {
+                error = response.errorMessage();
+            }
+        });
+        http.drain();
+        if (!error.empty()) {
+            throw std::runtime_error(error);
+        }
+        return responseBuffer;
+    }
+
+    // 把一段批量取價回應寫入 batch，快速解析失敗時退回完整的JSON解析
+    static void parsePrices(const std::string& readBuffer, TickerBatch& batch) {
+        bool parsed = TickerParser::parseArray(readBuffer, [&batch](std::string_view symbol, double price) {
+            batch.setPrice(symbol, price);
+        });
+        if (parsed) {
+            return;
+        }
+
+        try {
+            nlohmann::json response = nlohmann::json::parse(readBuffer);
+            if (!response.is_array()) {
+                throw std::runtime_error("Unexpected batch ticker response: " + readBuffer);
+            }
+            for (const auto& ticker : response) {
+                const std::string& symbol = ticker.at("symbol").get_ref<const std::string&>();
+                double price;
+                try {
+                    price = std::stod(ticker.at("price").get_ref<const std::string&>());
+                } catch (const std::invalid_argument&) {
+                    continue;  // 價格無法解析，該交易對保持為NaN
+                } catch (const std::out_of_range&) {
+                    continue;
+                }
+                batch.setPrice(symbol, price);
+            }
+        } catch (const nlohmann::json::exception& e) {
+            throw std::runtime_error("JSON parse error: " + std::string(e.what()));
+        }
+    }
+};
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+/**
+ * @brief 多生產者單消費者的有界無鎖佇列
+ *
+ * 每個槽位帶一個序號：生產者以 CAS 推進寫入索引搶到槽位後寫入資料，再把序號改為「已寫入」；
+ * 消費者只有一個，依序檢查槽位序號，不需要 CAS。
+ * 容量取2的冪。tryPush 在佇列已滿時立即回傳 false，任何執行緒被暫停都不會阻塞其他生產者搶位。
+ */
+template <typename T>
+class MpscQueue {
+    static_assert(std::is_trivially_copyable<T>::value, "MpscQueue requires a trivially copyable type");
+
+private:
+    static constexpr size_t CACHE_LINE = 64;
+
+    struct alignas(CACHE_LINE) Slot {
+        std::atomic<size_t> sequence;  // 等於位置時可寫，等於位置+1時可讀
+        T value;
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    size_t mask;
+
+    alignas(CACHE_LINE) std::atomic<size_t> tail;  // 生產者共用的寫入索引
+    alignas(CACHE_LINE) size_t head;               // 只由消費者使用
+
+public:
+    /**
+     * @param capacity 容量，必須是2的冪
+     */
+    explicit MpscQueue(size_t capacity)
+        : slots(new Slot[capacity])
+        , mask(capacity - 1)
+        , tail(0)
+        , head(0) {
+        if (capacity < 2 || (capacity & (capacity - 1)) != 0) {
+            throw std::runtime_error("MpscQueue capacity must be a power of two");
+        }
+        for (size_t i = 0; i < capacity; i++) {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    size_t capacity() const { return mask + 1; }
+
+    // 生產者（任意執行緒）：寫入一項，佇列已滿時回傳 false
+    bool tryPush(const T& value) {
+        size_t position = tail.load(std::memory_order_relaxed);
+        while (true) {
+            Slot& slot = slots[position & mask];
+            size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            if (sequence == position) {
+                if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    slot.value = value;
+                    slot.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (sequence < position) {
+                return false;  // 槽位仍存放上一輪的資料，佇列已滿
+            } else {
+                position = tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief 消費者：最多取出 maxItems 項，依序交給 consume
+     *
+     * 遇到已搶位但尚未寫完的槽位即停止，下次再取，保持先後次序。
+     * @return 取出的項數
+     */
+    template <typename Consumer>
+    size_t popBatch(Consumer&& consume, size_t maxItems) {
+        size_t count = 0;
+        while (count < maxItems) {
+            Slot& slot = slots[head & mask];
+            if (slot.sequence.load(std::memory_order_acquire) != head + 1) break;
+            consume(slot.value);
+            slot.sequence.store(head + mask + 1, std::memory_order_release);
+            head++;
+            count++;
+        }
+        return count;
+    }
+};
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+using PoolHandle = uint32_t;
+constexpr PoolHandle INVALID_POOL_HANDLE = std::numeric_limits<PoolHandle>::max();
+
+/**
+ * @brief 以空閒鏈表回收槽位的物件池
+ *
+ * 物件連續存放在一塊陣列中，以槽位編號作為穩定的句柄（陣列擴容不影響句柄）。
+ * 釋放的槽位進入空閒鏈表供下次分配重用，活躍物件數不變時記憶體不再增長。
+ * 被釋放的物件複製一份到固定容量的歸檔環形緩衝區，保留最近的歷史。
+ */
+template <typename T>
+class ObjectPool {
+private:
+    std::vector<T> slots;
+    std::vector<PoolHandle> freeSlots;
+    std::vector<T> archive;
+    size_t archiveCapacity;
+    size_t archiveHead;       // 歸檔已滿時下一個覆蓋的位置（即最舊的一筆）
+    uint64_t releasedCount;
+
+public:
+    /**
+     * @param archiveSize 歸檔保留的最近釋放物件數，0 表示不歸檔
+     */
+    explicit ObjectPool(size_t archiveSize)
+        : archiveCapacity(archiveSize)
+        , archiveHead(0)
+        , releasedCount(0) {
+        archive.reserve(archiveSize);
+    }
+
+    // 分配一個槽位並存入 value，優先重用已釋放的槽位
+    PoolHandle acquire(const T& value) {
+        if (!freeSlots.empty()) {
+            PoolHandle handle = freeSlots.back();
+            freeSlots.pop_back();
+            slots[handle] = value;
+            return handle;
+        }
+        slots.push_back(value);
+        return static_cast<PoolHandle>(slots.size() - 1);
+    }
+
+    T& get(PoolHandle handle) { return slots[handle]; }
+    const T& get(PoolHandle handle) const { return slots[handle]; }
+
+    // 釋放槽位：物件寫入歸檔，槽位歸還空閒鏈表
+    void release(PoolHandle handle) {
+        if (archiveCapacity > 0) {
+            if (archive.size() < archiveCapacity) {
+                archive.push_back(slots[handle]);
+            } else {
+                archive[archiveHead] = slots[handle];
+                archiveHead = (archiveHead + 1) % archiveCapacity;
+            }
+        }
+        freeSlots.push_back(handle);
+        releasedCount++;
+    }
+
+    size_t liveCount() const { return slots.size() - freeSlots.size(); }
+    size_t slotCount() const { return slots.size(); }
+    size_t archivedCount() const { return archive.size(); }
+    uint64_t totalReleased() const { return releasedCount; }
+
+    // 由舊到新遍歷歸檔
+    template <typename Visitor>
+    void forEachArchived(Visitor&& visit) const {
+        for (size_t i = 0; i < archive.size(); i++) {
+            visit(archive[(archiveHead + i) % archive.size()]);
+        }
+    }
+};
@@ -0,0 +1,382 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "market_data_client.h"
+#include "price_stream.h"
+#include "ticker_parser.h"
+
+/**
+ * @brief 單一價位
+ */
+struct BookLevel {
+    double price;
+    double quantity;
+};
+
+enum class BookUpdateResult {
+    Applied,  // 已套用
+    Stale,    // 早於快照，忽略
+    Gap       // 序號不連續，需要重新同步
+};
+
+/**
+ * @brief 單一交易對的L2訂單簿
+ *
+ * 買賣兩側各以連續陣列保存，最優價位放在陣列尾端：
+ * 查詢最優買賣價為O(1)，靠近盤口的更新只移動少量元素。
+ */
+class OrderBook {
+private:
+    std::vector<BookLevel> bids;  // 價格遞增，尾端為最高買價
+    std::vector<BookLevel> asks;  // 價格遞減，尾端為最低賣價
+    uint64_t lastUpdateId;
+    bool synced;
+    size_t maxDepth;
+
+public:
+    explicit OrderBook(size_t depth = 1000)
+        : lastUpdateId(0)
+        , synced(false)
+        , maxDepth(depth) {
+        bids.reserve(maxDepth * 2);
+        asks.reserve(maxDepth * 2);
+    }
+
+    /**
+     * @brief 以REST快照重建訂單簿
+     * @param snapshot /api/v3/depth 回應
+     */
+    void applySnapshot(const nlohmann::json& snapshot) {
+        bids.clear();
+        asks.clear();
+        lastUpdateId = snapshot.at("lastUpdateId").get<uint64_t>();
+
+        // 快照按最優價在前排列，反向寫入使最優價位於尾端
+        const auto& snapshotBids = snapshot.at("bids");
+        for (auto it = snapshotBids.rbegin(); it != snapshotBids.rend(); ++it) {
+            bids.push_back(parseLevel(*it));
+        }
+        const auto& snapshotAsks = snapshot.at("asks");
+        for (auto it = snapshotAsks.rbegin(); it != snapshotAsks.rend(); ++it) {
+            asks.push_back(parseLevel(*it));
+        }
+        synced = true;
+    }
+
+    /**
+     * @brief 套用增量深度事件
+     * @param update depthUpdate 訊息（U/u 為首末更新序號，b/a 為變動價位）
+     */
+    BookUpdateResult applyDiff(const nlohmann::json& update) {
+        uint64_t firstId = update.at("U").get<uint64_t>();
+        uint64_t finalId = update.at("u").get<uint64_t>();
+
+        if (finalId <= lastUpdateId) {
+            return BookUpdateResult::Stale;
+        }
+        if (firstId > lastUpdateId + 1) {
+            synced = false;
+            return BookUpdateResult::Gap;
+        }
+
+        for (const auto& level : update.at("b")) {
+            updateLevel(bids, parseLevel(level), true);
+        }
+        for (const auto& level : update.at("a")) {
+            updateLevel(asks, parseLevel(level), false);
+        }
+        lastUpdateId = finalId;
+        return BookUpdateResult::Applied;
+    }
+
+    bool isSynced() const { return synced; }
+    void invalidate() { synced = false; }
+    uint64_t getLastUpdateId() const { return lastUpdateId; }
+
+    double bestBid() const { return bids.empty() ? 0 : bids.back().price; }
+    double bestAsk() const { return asks.empty() ? 0 : asks.back().price; }
+    double bestBidQuantity() const { return bids.empty() ? 0 : bids.back().quantity; }
+    double bestAskQuantity() const { return asks.empty() ? 0 : asks.back().quantity; }
+    size_t bidDepth() const { return bids.size(); }
+    size_t askDepth() const { return asks.size(); }
+
+private:
+    static BookLevel parseLevel(const nlohmann::json& level) {
+        BookLevel result{0, 0};
+        const std::string& price = level.at(0).get_ref<const std::string&>();
+        const std::string& quantity = level.at(1).get_ref<const std::string&>();
+        if (!TickerParser::parseDecimal(price, result.price) ||
+            !TickerParser::parseDecimal(quantity, result.quantity)) {
+            throw std::runtime_error("Invalid depth level: " + level.dump());
+        }
+        return result;
+    }
+
+    /**
+     * @brief 更新或刪除一個價位，數量為0表示刪除
+     * @param isBid 買方陣列按價格遞增，賣方按價格遞減
+     */
+    void updateLevel(std::vector<BookLevel>& side, const BookLevel& level, bool isBid) {
+        auto it = isBid
+            ? std::lower_bound(side.begin(), side.end(), level.price,
+                               [](const BookLevel& l, double p) { return l.price < p; })
+            : std::lower_bound(side.begin(), side.end(), level.price,
+                               [](const BookLevel& l, double p) { return l.price > p; });
+
+        bool exists = it != side.end() && it->price == level.price;
+        if (level.quantity == 0) {
+            if (exists) side.erase(it);
+            return;
+        }
+        if (exists) {
+            it->quantity = level.quantity;
+            return;
+        }
+        side.insert(it, level);
+
+        // 遠離盤口的價位堆積到兩倍深度時一次性裁剪
+        if (side.size() > maxDepth * 2) {
+            side.erase(side.begin(), side.begin() + (side.size() - maxDepth));
+        }
+    }
+};
+
+/**
+ * @brief 以REST快照加增量深度流維護多個交易對的訂單簿
+ *
+ * 同步流程（依Binance文件）：先緩存增量事件，再取快照，
+ * 丟棄早於快照的事件後依序套用；發現序號缺口或重連時重新同步。
+ * 快照由專屬的快照執行緒逐一取得並解析，接收行情的執行緒只登記請求、
+ * 在之後的事件中取回結果套用，不因REST請求而阻塞。
+ * 同一交易對同時至多一個快照請求，失敗（請求出錯或快照早於緩存事件）後按指數退避再請求，
+ * 未同步的交易對不會在每筆事件上重複取快照。
+ * 最優買賣價變動時回調 onTouch。
+ */
+class OrderBookFeed {
+public:
+    using TouchHandler = std::function<void(const PriceUpdate&)>;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct BookState {
+        OrderBook book;
+        std::vector<nlohmann::json> pending;  // 同步前緩存的增量事件
+        bool requested = false;               // 快照請求已交給快照執行緒，結果尚未套用
+        int failures = 0;                     // 連續同步失敗次數，決定退避時間
+        Clock::time_point nextAttempt;        // 退避結束前不再請求快照
+    };
+
+    // 快照執行緒取回的結果
+    struct SnapshotResult {
+        std::string symbol;
+        nlohmann::json snapshot;
+        std::string error;  // 非空表示取快照失敗
+    };
+
+    MarketDataClient& rest;  // 只由快照執行緒使用
+    std::unordered_map<std::string, BookState> books;
+    TouchHandler onTouch;
+    PriceUpdate touch;
+    int snapshotLimit;
+
+    // 接收執行緒與快照執行緒之間的請求與結果，只在未同步時使用
+    std::mutex snapshotMutex;
+    std::condition_variable snapshotWake;
+    std::deque<std::string> snapshotRequests;
+    std::vector<SnapshotResult> snapshotResults;
+    std::atomic<bool> resultsAvailable;  // 讓接收執行緒不加鎖即可判斷有無結果
+    bool stopping;
+    std::thread snapshotWorker;
+
+    static constexpr size_t MAX_PENDING = 1000;
+    static constexpr long long MIN_RETRY_MS = 500;
+    static constexpr long long MAX_RETRY_MS = 30000;
+
+public:
+    OrderBookFeed(MarketDataClient& client, TouchHandler handler, int limit = 1000)
+        : rest(client)
+        , onTouch(std::move(handler))
+        , snapshotLimit(limit)
+        , resultsAvailable(false)
+        , stopping(false) {
+        snapshotWorker = std::thread([this]() { snapshotLoop(); });
+    }
+
+    ~OrderBookFeed() {
+        {
+            std::lock_guard<std::mutex> lock(snapshotMutex);
+            stopping = true;
+        }
+        snapshotWake.notify_one();
+        snapshotWorker.join();
+    }
+
+    OrderBookFeed(const OrderBookFeed&) = delete;
+    OrderBookFeed& operator=(const OrderBookFeed&) = delete;
+
+    void addSymbol(const std::string& symbol) {
+        books.emplace(symbol, BookState{OrderBook(static_cast<size_t>(snapshotLimit)), {}});
+    }
+
+    const OrderBook* getBook(const std::string& symbol) const {
+        auto it = books.find(symbol);
+        return it == books.end() ? nullptr : &it->second.book;
+    }
+
+    // 串流重連後所有訂單簿都需要重新同步
+    void onReconnect() {
+        for (auto& [symbol, state] : books) {
+            state.book.invalidate();
+            state.pending.clear();
+        }
+    }
+
+    // 處理一筆 depthUpdate 訊息
+    void onDepthUpdate(const nlohmann::json& update) {
+        try {
+            processDepthUpdate(update);
+        } catch (const nlohmann::json::exception& e) {
+            throw std::runtime_error("Malformed depth update: " + std::string(e.what()));
+        }
+    }
+
+private:
+    void processDepthUpdate(const nlohmann::json& update) {
+        if (resultsAvailable.load(std::memory_order_acquire)) {
+            applySnapshotResults();
+        }
+
+        const std::string& symbol = update.at("s").get_ref<const std::string&>();
+        auto it = books.find(symbol);
+        if (it == books.end()) return;
+        BookState& state = it->second;
+
+        if (!state.book.isSynced()) {
+            if (state.pending.size() >= MAX_PENDING) {
+                state.pending.erase(state.pending.begin(), state.pending.begin() + MAX_PENDING / 2);
+            }
+            state.pending.push_back(update);
+            requestSnapshot(symbol, state);
+            return;
+        }
+
+        double previousBid = state.book.bestBid();
+        double previousAsk = state.book.bestAsk();
+        if (state.book.applyDiff(update) == BookUpdateResult::Gap) {
+            std::cerr << "Depth sequence gap for " << symbol << ", resyncing" << std::endl;
+            state.pending.push_back(update);
+            requestSnapshot(symbol, state);
+            return;
+        }
+        if (state.book.bestBid() != previousBid || state.book.bestAsk() != previousAsk) {
+            publishTouch(symbol, state.book, update.value("E", 0LL));
+        }
+    }
+
+    // 沒有進行中的請求且不在退避期間時，把快照請求交給快照執行緒
+    void requestSnapshot(const std::string& symbol, BookState& state) {
+        if (state.requested || Clock::now() < state.nextAttempt) return;
+        state.requested = true;
+        {
+            std::lock_guard<std::mutex> lock(snapshotMutex);
+            snapshotRequests.push_back(symbol);
+        }
+        snapshotWake.notify_one();
+    }
+
+    // 套用快照執行緒取回的快照並重放緩存事件；失敗時排定退避後的下一次請求
+    void applySnapshotResults() {
+        std::vector<SnapshotResult> results;
+        {
+            std::lock_guard<std::mutex> lock(snapshotMutex);
+            results.swap(snapshotResults);
+            resultsAvailable.store(false, std::memory_order_relaxed);
+        }
+
+        for (SnapshotResult& result : results) {
+            auto it = books.find(result.symbol);
+            if (it == books.end()) continue;
+            BookState& state = it->second;
+            state.requested = false;
+            if (state.book.isSynced()) continue;
+
+            std::string error = result.error;
+            if (error.empty()) {
+                try {
+                    state.book.applySnapshot(result.snapshot);
+                    for (const auto& pendingUpdate : state.pending) {
+                        if (state.book.applyDiff(pendingUpdate) == BookUpdateResult::Gap) {
+                            error = "snapshot older than buffered updates";
+                            break;
+                        }
+                    }
+                } catch (const std::exception& e) {
+                    error = e.what();
+                }
+            }
+
+            if (error.empty()) {
+                state.pending.clear();
+                state.failures = 0;
+                std::cout << "Order book synced for " << result.symbol
+                          << " (lastUpdateId: " << state.book.getLastUpdateId() << ")" << std::endl;
+                publishTouch(result.symbol, state.book, 0);
+                continue;
+            }
+
+            // 保留緩存，退避後由下一筆事件再請求
+            state.book.invalidate();
+            long long delayMs = std::min(MAX_RETRY_MS, MIN_RETRY_MS << std::min(state.failures, 6));
+            state.failures++;
+            state.nextAttempt = Clock::now() + std::chrono::milliseconds(delayMs);
+            std::cerr << "Order book sync failed for " << result.symbol << ": " << error
+                      << ", retrying in " << delayMs << " ms" << std::endl;
+        }
+    }
+
+    // 快照執行緒：依序取得請求的快照，結果交回接收執行緒套用
+    void snapshotLoop() {
+        std::unique_lock<std::mutex> lock(snapshotMutex);
+        while (true) {
+            snapshotWake.wait(lock, [this]() { return stopping || !snapshotRequests.empty(); });
+            if (stopping) return;
+            SnapshotResult result{std::move(snapshotRequests.front()), nlohmann::json(), std::string()};
+            snapshotRequests.pop_front();
+            lock.unlock();
+
+            try {
+                result.snapshot = rest.getDepthSnapshot(result.symbol, snapshotLimit);
+            } catch (const std::exception& e) {
+                result.error = e.what();
+            }
+
+            lock.lock();
+            snapshotResults.push_back(std::move(result));
+            resultsAvailable.store(true, std::memory_order_release);
+        }
+    }
+
+    void publishTouch(const std::string& symbol, const OrderBook& book, long long eventTime) {
+        if (book.bestBid() <= 0 || book.bestAsk() <= 0) return;
+        touch.symbol = symbol;
+        touch.bidPrice = book.bestBid();
+        touch.askPrice = book.bestAsk();
+        touch.price = (touch.bidPrice + touch.askPrice) / 2;
+        touch.eventTime = eventTime;
+        onTouch(touch);
+    }
+};
@@ -0,0 +1,360 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "fixed_decimal.h"
+#include "object_pool.h"
+#include "mpsc_queue.h"
+#include "spsc_ring.h"
+
+// 訂單方向
+enum class OrderSide : uint8_t { Buy, Sell };
+
+inline const char* sideName(OrderSide side) {
+    return side == OrderSide::Buy ? "buy" : "sell";
+}
+
+// 下單意圖
+enum class OrderAction : uint8_t {
+    New,     // 新訂單
+    Cancel,  // 撤銷 orderId
+    Amend,   // 以 orderId 替換 originalOrderId（撤單後以新價格、數量重下）
+    Query,   // 查詢 orderId 的狀態與成交（由閘道輪詢掛單中的訂單，策略不送出）
+};
+
+/**
+ * @brief 策略執行緒 -> 訂單閘道的請求，定長且可直接複製
+ */
+struct OrderRequest {
+    uint64_t orderId;
+    uint64_t originalOrderId;  // Amend 時被替換的訂單，其餘與 orderId 相同
+    Price price;
+    Quantity quantity;
+    uint32_t strategy;         // 策略下標，回報送回該策略的佇列
+    PoolHandle handle;         // 策略訂單池中的句柄，原樣帶回回報
+    OrderAction action;
+    OrderSide side;
+};
+
+// 交易所回報類型
+enum class OrderReplyType : uint8_t {
+    Accepted,         // 交易所已接受（掛單中）
+    Rejected,         // 被拒絕，reason 為原因
+    Canceled,         // 已撤銷
+    Filled,           // 已完全成交
+    PartiallyFilled,  // 部分成交，不結束訂單，之後另有該請求的狀態回報
+};
+
+/**
+ * @brief 訂單閘道 -> 策略執行緒的回報，定長且可直接複製
+ *
+ * 傳輸層只需填寫 orderId、type、action 與成交資訊；strategy、handle 與 side 由閘道按 orderId 對應回原請求後填入。
+ * 每筆請求的每個訂單ID恰好產生一筆狀態回報（新訂單立即成交時只回報 Filled），
+ * 已有成交但訂單未完全成交時（例如部分成交後撤銷），先送出一筆 PartiallyFilled。
+ * 傳輸層填寫的 quantity 與 amount 是交易所回報的累計成交，閘道轉為本次新增的成交後再交給策略，
+ * 同一成交被多次查詢到時只記一次。
+ */
+struct OrderReply {
+    static constexpr size_t REASON_LENGTH = 63;
+
+    uint64_t orderId;
+    Price price;              // 成交均價（Filled、PartiallyFilled，由閘道按 amount / quantity 計算）
+    Quantity quantity;        // 成交數量（Filled、PartiallyFilled）
+    Notional amount;          // 成交金額（Filled、PartiallyFilled）
+    uint32_t strategy;
+    PoolHandle handle;
+    OrderReplyType type;
+    OrderAction action;       // 產生此回報的請求，用於區分下單被拒與撤單失敗
+    OrderSide side;
+    int32_t errorCode;        // 交易所錯誤碼，沒有時為0
+    char reason[REASON_LENGTH + 1];
+
+    static OrderReply make(uint64_t orderId, OrderReplyType type, OrderAction action, int32_t errorCode = 0,
+                           const char* text = "") {
+        OrderReply reply{};
+        reply.orderId = orderId;
+        reply.type = type;
+        reply.action = action;
+        reply.errorCode = errorCode;
+        std::strncpy(reply.reason, text, REASON_LENGTH);
+        return reply;
+    }
+};
+
+/**
+ * @brief 非同步訂單閘道
+ *
+ * 策略執行緒以 submit() 把下單、撤單、改單意圖寫入無鎖的多生產者佇列後立即返回，
+ * 佇列已滿時回傳 false 而不等待，下單永遠不阻塞行情處理。
+ * 閘道執行緒按順序取出請求交給傳輸層（序列化、簽名、送出），
+ * 傳輸層收到交易所回應後在閘道執行緒上呼叫 onResponse()，閘道按訂單ID對應回原請求，
+ * 把回報寫入該策略專屬的單生產者單消費者回報佇列，由策略執行緒在處理行情前取走。
+ * 未設定傳輸層時以模擬撮合回應：新訂單與改單即時接受，撤單即時成功。
+ * 同一訂單ID可能同時有多筆請求在途（例如下單狀態未知正在查詢時又撤單），
+ * 對應關係保留到訂單已結束且所有在途請求都已回報為止，遲到的回報仍能送回所屬策略。
+ * 設定傳輸層時可開啟狀態輪詢：每個輪詢間隔至多查詢一筆已被接受、沒有在途請求的掛單，
+ * 按最久未查詢的順序輪流，掛單中的訂單成交後不必等到撤單才回報。
+ * 策略撤銷已結束的訂單時（例如輪詢已回報成交），閘道直接回報拒絕，不再送往交易所。
+ */
+class OrderGateway {
+public:
+    // 送出一筆請求（閘道執行緒上呼叫），回應稍後經 onResponse() 回報
+    using SendHandler = std::function<void(const OrderRequest&)>;
+    // 推進進行中的傳輸並觸發回應回調，回傳本次完成的回應數（閘道執行緒上呼叫，不可阻塞）
+    using PollHandler = std::function<size_t()>;
+
+private:
+    // 已送出且尚未結束的訂單
+    struct InFlight {
+        uint32_t strategy;
+        PoolHandle handle;
+        OrderSide side;
+        uint32_t outstanding;  // 尚未回報的請求數
+        bool finished;         // 已收到拒絕、撤銷或成交
+        Quantity filled;       // 已交給策略的累計成交數量
+        Notional filledAmount; // 已交給策略的累計成交金額
+        long long queriedMs;   // 上次狀態輪詢的時間（steady_clock 毫秒），0 表示未曾查詢
+    };
+
+    static constexpr size_t MAX_REQUEST_BATCH = 64;
+
+    MpscQueue<OrderRequest> requests;
+    std::vector<std::unique_ptr<SpscRing<OrderReply>>> replies;  // 策略 -> 回報佇列
+    std::vector<std::vector<OrderReply>> undelivered;            // 策略 -> 回報佇列已滿時暫存的回報
+    std::unordered_map<uint64_t, InFlight> inFlight;             // 訂單ID -> 所屬策略，只由閘道執行緒使用
+    SendHandler sendHandler;
+    PollHandler pollHandler;
+    long long statusPollIntervalMs;  // 0 表示不輪詢
+    long long nextStatusPollMs;
+    std::atomic<bool> running;
+    std::thread worker;
+
+public:
+    /**
+     * @param queueCapacity 請求佇列與每個回報佇列的容量，必須是2的冪
+     * @param strategies 策略數量（請求的 strategy 欄位小於此值）
+     */
+    OrderGateway(size_t queueCapacity, size_t strategies)
+        : requests(queueCapacity)
+        , undelivered(strategies)
+        , statusPollIntervalMs(0)
+        , nextStatusPollMs(0)
+        , running(false) {
+        for (size_t i = 0; i < strategies; i++) {
+            replies.push_back(std::make_unique<SpscRing<OrderReply>>(queueCapacity));
+        }
+    }
+
+    ~OrderGateway() {
+        stop();
+    }
+
+    OrderGateway(const OrderGateway&) = delete;
+    OrderGateway& operator=(const OrderGateway&) = delete;
+
+    // 設定傳輸層，須在 start() 之前呼叫；send 為空時使用模擬撮合
+    void setTransport(SendHandler send, PollHandler poll) {
+        sendHandler = std::move(send);
+        pollHandler = std::move(poll);
+    }
+
+    // 設定掛單狀態輪詢的間隔（每個間隔至多一筆查詢），0 表示不輪詢；只在設定傳輸層時生效，須在 start() 之前呼叫
+    void setStatusPolling(std::chrono::milliseconds interval) {
+        statusPollIntervalMs = interval.count();
+    }
+
+    void start() {
+        if (running.exchange(true)) return;
+        worker = std::thread([this]() { run(); });
+    }
+
+    void stop() {
+        running = false;
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+
+    // 是否以模擬撮合回應（未設定傳輸層），模擬撮合不回報成交
+    bool simulated() const { return !sendHandler; }
+
+    // 策略執行緒：提交一筆請求，佇列已滿時回傳 false（不等待）
+    bool submit(const OrderRequest& request) {
+        return requests.tryPush(request);
+    }
+
+    /**
+     * @brief 策略執行緒：取出該策略最多 maxReplies 筆回報，依序交給 consume
+     * @return 取出的回報數
+     */
+    template <typename Consumer>
+    size_t drainReplies(uint32_t strategy, Consumer&& consume, size_t maxReplies) {
+        return replies[strategy]->popBatch(consume, maxReplies);
+    }
+
+    /**
+     * @brief 傳輸層回調（閘道執行緒）：按訂單ID對應回原請求，寫入所屬策略的回報佇列
+     *
+     * 成交回報的累計數量與金額在此轉為新增部分；沒有新增成交的 PartiallyFilled 不送出。
+     */
+    void onResponse(OrderReply reply) {
+        auto it = inFlight.find(reply.orderId);
+        if (it == inFlight.end()) {
+            std::cerr << "Order gateway: reply for unknown order " << reply.orderId << std::endl;
+            return;
+        }
+        InFlight& entry = it->second;
+        reply.strategy = entry.strategy;
+        reply.handle = entry.handle;
+        reply.side = entry.side;
+        if (reply.type == OrderReplyType::Filled || reply.type == OrderReplyType::PartiallyFilled) {
+            takeNewFill(entry, reply);
+            if (reply.type == OrderReplyType::PartiallyFilled) {
+                if (reply.quantity > Quantity()) deliver(reply);
+                return;
+            }
+        }
+        if (entry.outstanding > 0) entry.outstanding--;
+        // 查詢失敗不代表訂單已結束，之後繼續輪詢
+        if (reply.type != OrderReplyType::Accepted
+            && !(reply.action == OrderAction::Query && reply.type == OrderReplyType::Rejected)) {
+            entry.finished = true;
+        }
+        if (entry.finished && entry.outstanding == 0) {
+            inFlight.erase(it);
+        }
+        deliver(reply);
+    }
+
+private:
+    void run() {
+        IdleBackoff backoff(std::chrono::microseconds(200));
+        while (running) {
+            size_t flushed = flushUndelivered();
+            size_t sent = requests.popBatch([this](const OrderRequest& request) { send(request); },
+                                            MAX_REQUEST_BATCH);
+            size_t completed = pollHandler ? pollHandler() : 0;
+            size_t queried = pollStatus();
+            if (sent + completed + flushed + queried == 0) {
+                backoff.idle();
+            } else {
+                backoff.reset();
+            }
+        }
+    }
+
+    void send(const OrderRequest& request) {
+        // 訂單已結束且所有回報都已送出：撤單不必再送往交易所
+        if (request.action == OrderAction::Cancel && inFlight.find(request.orderId) == inFlight.end()) {
+            OrderReply reply = OrderReply::make(request.orderId, OrderReplyType::Rejected, request.action, 0,
+                                                "Order already closed");
+            reply.strategy = request.strategy;
+            reply.handle = request.handle;
+            reply.side = request.side;
+            deliver(reply);
+            return;
+        }
+        auto it = inFlight.try_emplace(
+            request.orderId,
+            InFlight{request.strategy, request.handle, request.side, 0, false, Quantity(), Notional(), 0}).first;
+        it->second.outstanding++;
+        if (request.action == OrderAction::Amend && request.originalOrderId != request.orderId) {
+            auto original = inFlight.find(request.originalOrderId);
+            if (original != inFlight.end()) original->second.outstanding++;
+        }
+        if (sendHandler) {
+            sendHandler(request);
+            return;
+        }
+
+        // 模擬撮合
+        switch (request.action) {
+            case OrderAction::New:
+                onResponse(OrderReply::make(request.orderId, OrderReplyType::Accepted, request.action));
+                break;
+            case OrderAction::Cancel:
+                onResponse(OrderReply::make(request.orderId, OrderReplyType::Canceled, request.action));
+                break;
+            case OrderAction::Amend:
+                onResponse(OrderReply::make(request.originalOrderId, OrderReplyType::Canceled, request.action));
+                onResponse(OrderReply::make(request.orderId, OrderReplyType::Accepted, request.action));
+                break;
+            case OrderAction::Query:
+                onResponse(OrderReply::make(request.orderId, OrderReplyType::Accepted, request.action));
+                break;
+        }
+    }
+
+    /**
+     * @brief 到達輪詢時間時查詢一筆掛單中、沒有在途請求且最久未查詢的訂單
+     * @return 送出的查詢數（0 或 1）
+     */
+    size_t pollStatus() {
+        if (statusPollIntervalMs <= 0 || !sendHandler || inFlight.empty()) return 0;
+        long long now = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        if (now < nextStatusPollMs) return 0;
+
+        auto oldest = inFlight.end();
+        for (auto it = inFlight.begin(); it != inFlight.end(); ++it) {
+            const InFlight& entry = it->second;
+            if (entry.finished || entry.outstanding > 0) continue;
+            if (oldest == inFlight.end() || entry.queriedMs < oldest->second.queriedMs) oldest = it;
+        }
+        if (oldest == inFlight.end()) return 0;
+
+        nextStatusPollMs = now + statusPollIntervalMs;
+        InFlight& entry = oldest->second;
+        entry.queriedMs = now;
+        send(OrderRequest{oldest->first, oldest->first, Price(), Quantity(), entry.strategy, entry.handle,
+                          OrderAction::Query, entry.side});
+        return 1;
+    }
+
+    // 累計成交 -> 本次新增的成交；查詢結果較舊（累計不大於已記錄的）時新增為0
+    static void takeNewFill(InFlight& entry, OrderReply& reply) {
+        if (reply.quantity <= entry.filled) {
+            reply.quantity = Quantity();
+            reply.amount = Notional();
+            reply.price = Price();
+            return;
+        }
+        Quantity total = reply.quantity;
+        Notional totalAmount = reply.amount;
+        reply.quantity = total - entry.filled;
+        reply.amount = totalAmount - entry.filledAmount;
+        reply.price = averagePrice(reply.amount, reply.quantity);
+        entry.filled = total;
+        entry.filledAmount = totalAmount;
+    }
+
+    // 回報佇列已滿時暫存，下一輪重試，閘道不因策略執行緒落後而停頓
+    void deliver(const OrderReply& reply) {
+        std::vector<OrderReply>& pending = undelivered[reply.strategy];
+        if (!pending.empty() || !replies[reply.strategy]->tryPush(reply)) {
+            pending.push_back(reply);
+        }
+    }
+
+    size_t flushUndelivered() {
+        size_t flushed = 0;
+        for (size_t strategy = 0; strategy < undelivered.size(); strategy++) {
+            std::vector<OrderReply>& pending = undelivered[strategy];
+            size_t count = 0;
+            while (count < pending.size() && replies[strategy]->tryPush(pending[count])) {
+                count++;
+            }
+            pending.erase(pending.begin(), pending.begin() + static_cast<std::ptrdiff_t>(count));
+            flushed += count;
+        }
+        return flushed;
+    }
+};
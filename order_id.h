@@ -0,0 +1,134 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <stdexcept>
+
+/**
+ * @brief 訂單ID中各欄位的拆解結果
+ */
+struct OrderIdFields {
+    uint64_t epochSeconds;  // 進程啟動時間（自 2024-01-01 起的秒數，序號溢出時會向前借用）
+    uint32_t sequence;      // 同一秒內的序號
+    uint32_t symbolId;      // 交易對編號
+    uint32_t levelBits;     // 網格索引的低位
+};
+
+/**
+ * @brief 可直接作為交易所 newClientOrderId 的定長字串
+ *
+ * 以 "-0-9A-Z_a-z" 共64個字元（按ASCII順序排列）每字元編碼6位，
+ * 64位ID固定為11個字元，字典序與數值順序一致，不分配堆記憶體。
+ */
+struct ClientOrderId {
+    static constexpr size_t LENGTH = 11;
+    char text[LENGTH + 1];
+
+    const char* c_str() const { return text; }
+};
+
+inline std::ostream& operator<<(std::ostream& out, const ClientOrderId& id) {
+    return out << id.text;
+}
+
+/**
+ * @brief 無鎖的64位訂單ID生成器
+ *
+ * 位元布局（高位到低位）：
+ *   [63:36] 進程啟動秒數（28位，約8.5年循環）
+ *   [35:20] 序號（16位）
+ *   [19:12] 交易對編號（8位）
+ *   [11:0]  網格索引低12位
+ * 啟動秒數與序號合為一個44位計數器，以原子 fetch_add 遞增，多個策略執行緒可同時調用；
+ * 序號溢出時進位到秒數欄位，只要平均下單速率低於每秒65536筆，重啟後的ID不會與之前重複。
+ */
+class OrderIdGenerator {
+private:
+    static constexpr unsigned LEVEL_BITS = 12;
+    static constexpr unsigned SYMBOL_BITS = 8;
+    static constexpr unsigned SEQUENCE_BITS = 16;
+    static constexpr unsigned EPOCH_BITS = 28;
+    static constexpr unsigned COUNTER_SHIFT = LEVEL_BITS + SYMBOL_BITS;
+    static constexpr uint64_t CUSTOM_EPOCH = 1704067200;  // 2024-01-01T00:00:00Z
+
+    static constexpr char ALPHABET[] = "-0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ_abcdefghijklmnopqrstuvwxyz";
+
+    std::atomic<uint64_t> counter;  // 啟動秒數 << SEQUENCE_BITS | 序號
+
+    static uint64_t mask(unsigned bits) { return (uint64_t(1) << bits) - 1; }
+
+public:
+    static constexpr uint32_t MAX_SYMBOLS = 1u << SYMBOL_BITS;
+
+    OrderIdGenerator()
+        : counter(startEpoch() << SEQUENCE_BITS) {}
+
+    OrderIdGenerator(const OrderIdGenerator&) = delete;
+    OrderIdGenerator& operator=(const OrderIdGenerator&) = delete;
+
+    /**
+     * @brief 生成下一個訂單ID
+     * @param symbolId 交易對編號（0 到 MAX_SYMBOLS - 1）
+     * @param levelIndex 下單的網格索引，只保留低12位
+     */
+    uint64_t next(uint32_t symbolId, long long levelIndex) {
+        uint64_t count = counter.fetch_add(1, std::memory_order_relaxed) & mask(EPOCH_BITS + SEQUENCE_BITS);
+        return count << COUNTER_SHIFT
+             | (uint64_t(symbolId) & mask(SYMBOL_BITS)) << LEVEL_BITS
+             | (static_cast<uint64_t>(levelIndex) & mask(LEVEL_BITS));
+    }
+
+    static OrderIdFields decode(uint64_t orderId) {
+        return OrderIdFields{
+            (orderId >> (COUNTER_SHIFT + SEQUENCE_BITS)) & mask(EPOCH_BITS),
+            static_cast<uint32_t>((orderId >> COUNTER_SHIFT) & mask(SEQUENCE_BITS)),
+            static_cast<uint32_t>((orderId >> LEVEL_BITS) & mask(SYMBOL_BITS)),
+            static_cast<uint32_t>(orderId & mask(LEVEL_BITS))};
+    }
+
+    // 編碼為交易所 newClientOrderId 字串
+    static ClientOrderId encode(uint64_t orderId) {
+        ClientOrderId id;
+        for (size_t i = ClientOrderId::LENGTH; i-- > 0;) {
+            id.text[i] = ALPHABET[orderId & 63];
+            orderId >>= 6;
+        }
+        id.text[ClientOrderId::LENGTH] = '\0';
+        return id;
+    }
+
+    // 解析交易所回報中的 clientOrderId
+    static uint64_t parse(const char* text) {
+        uint64_t orderId = 0;
+        for (size_t i = 0; i < ClientOrderId::LENGTH; i++) {
+            int digit = digitOf(text[i]);
+            if (digit < 0) {
+                throw std::runtime_error("Invalid client order id");
+            }
+            orderId = orderId << 6 | static_cast<uint64_t>(digit);
+        }
+        if (text[ClientOrderId::LENGTH] != '\0') {
+            throw std::runtime_error("Invalid client order id");
+        }
+        return orderId;
+    }
+
+private:
+    static uint64_t startEpoch() {
+        long long now = std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        uint64_t seconds = now > static_cast<long long>(CUSTOM_EPOCH) ? now - CUSTOM_EPOCH : 0;
+        return seconds & mask(EPOCH_BITS);
+    }
+
+    static int digitOf(char c) {
+        if (c == '-') return 0;
+        if (c >= '0' && c <= '9') return 1 + (c - '0');
+        if (c >= 'A' && c <= 'Z') return 11 + (c - 'A');
+        if (c == '_') return 37;
+        if (c >= 'a' && c <= 'z') return 38 + (c - 'a');
+        return -1;
+    }
+};
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+#include "fixed_decimal.h"
+#include "order_gateway.h"
+
+// 訂單狀態位元
+enum OrderStatus : uint8_t {
+    ORDER_OPEN = 1 << 0,      // 訂單仍然有效
+    ORDER_CLOSED = 1 << 1,    // 因網格移動或間距改變而關閉
+    ORDER_ACKED = 1 << 2,     // 交易所已接受
+    ORDER_REJECTED = 1 << 3,  // 被訂單閘道或交易所拒絕
+    ORDER_FILLED = 1 << 4,    // 交易所回報已完全成交
+};
+
+// 訂單結構體（可直接複製的定長記錄，字串ID只在日誌與交易所邊界生成）
+struct Order {
+    uint64_t orderId;
+    Price price;
+    Quantity quantity;
+    Price gridLevel;   // 對應的網格線價格
+    OrderSide side;
+    uint8_t status;    // OrderStatus 位元組合
+    
+    bool isOpen() const { return (status & ORDER_OPEN) != 0; }
+    
+    void close() { status = (status & ~ORDER_OPEN) | ORDER_CLOSED; }
+};
+
+static_assert(std::is_trivially_copyable<Order>::value, "Order must stay trivially copyable");
+static_assert(sizeof(Order) <= 48, "Order must fit in 48 bytes");
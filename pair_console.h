@@ -0,0 +1,107 @@
+#pragma once
+
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+
+/**
+ * @brief 單一交易對的輸出流
+ *
+ * 寫入的內容先暫存，遇到 std::endl 或 flush 時把完整的行逐行加上 "[交易對] " 前綴，
+ * 在輸出鎖內一次寫入共用的目標流，多個工作執行緒的訊息不會在行內交錯，也能分辨來源。
+ * 多行的狀態輸出以 Block 在整塊期間持有輸出鎖，期間各行不再重複加鎖。
+ * 同一實例只由處理該交易對的執行緒使用。
+ */
+class PairConsole : public std::ostream {
+private:
+    class LineBuffer : public std::stringbuf {
+    private:
+        PairConsole& owner;
+
+    public:
+        explicit LineBuffer(PairConsole& console) : owner(console) {}
+
+    protected:
+        int sync() override {
+            owner.writeLines();
+            return 0;
+        }
+    };
+
+    LineBuffer buffer;
+    std::ostream& target;
+    std::mutex* lock;    // 共用 target 時的輸出鎖，獨佔時為 nullptr
+    std::string prefix;
+    bool holding;        // 是否已由 Block 持有輸出鎖
+    std::string lines;   // 重用的待寫入內容
+
+public:
+    /**
+     * @brief 整塊輸出期間持有輸出鎖，使多行輸出不與其他交易對交錯
+     */
+    class Block {
+    private:
+        PairConsole& console;
+        std::unique_lock<std::mutex> guard;
+
+    public:
+        explicit Block(PairConsole& pairConsole) : console(pairConsole) {
+            if (console.lock != nullptr) {
+                guard = std::unique_lock<std::mutex>(*console.lock);
+            }
+            console.holding = true;
+        }
+
+        ~Block() {
+            console.flush();
+            console.holding = false;
+        }
+
+        Block(const Block&) = delete;
+        Block& operator=(const Block&) = delete;
+    };
+
+    /**
+     * @param out 目標輸出流
+     * @param outLock 多個執行緒共用 out 時的輸出鎖，獨佔時為 nullptr
+     * @param symbol 交易對名稱，作為每行的前綴
+     */
+    PairConsole(std::ostream& out, std::mutex* outLock, const std::string& symbol)
+        : std::ostream(nullptr)
+        , buffer(*this)
+        , target(out)
+        , lock(outLock)
+        , prefix("[" + symbol + "] ")
+        , holding(false) {
+        rdbuf(&buffer);
+    }
+
+    PairConsole(const PairConsole&) = delete;
+    PairConsole& operator=(const PairConsole&) = delete;
+
+private:
+    // 寫出暫存中完整的行，未以換行結尾的部分留待下次
+    void writeLines() {
+        lines = buffer.str();
+        size_t end = lines.rfind('\n');
+        if (end == std::string::npos) return;
+        buffer.str(lines.substr(end + 1));
+        buffer.pubseekoff(0, std::ios_base::end, std::ios_base::out);
+
+        std::unique_lock<std::mutex> guard;
+        if (lock != nullptr && !holding) {
+            guard = std::unique_lock<std::mutex>(*lock);
+        }
+        for (size_t start = 0; start <= end;) {
+            size_t newline = lines.find('\n', start);
+            if (newline > start) {
+                target << prefix;
+                target.write(lines.data() + start, static_cast<std::streamsize>(newline - start));
+            }
+            target << '\n';
+            start = newline + 1;
+        }
+        target.flush();
+    }
+};
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include "fixed_decimal.h"
+
+/**
+ * @brief 按固定時間桶彙總已實現盈虧的環形緩衝區
+ *
+ * 第 n 個桶覆蓋 [n * bucketMs, (n + 1) * bucketMs)，存放在 n mod 桶數 號槽位。
+ * 窗口總和隨寫入增量維護；時間前進時只清空被擠出的桶，
+ * 每次操作最多處理一圈桶數，與累計交易筆數無關。
+ */
+class PnlRollup {
+private:
+    struct Bucket {
+        long long number;  // 桶序號（時間 / bucketMs），-1 表示空
+        Notional pnl;
+    };
+
+    long long bucketMs;
+    std::vector<Bucket> buckets;
+    long long latest;     // 已寫入的最新桶序號
+    Notional windowPnl;   // 窗口內所有桶的盈虧總和
+
+    size_t slotOf(long long number) const {
+        return static_cast<size_t>(number % static_cast<long long>(buckets.size()));
+    }
+
+    // 前進到第 number 個桶，清空窗口外的舊桶
+    void advanceTo(long long number) {
+        if (number <= latest) return;
+        long long from = std::max(latest + 1, number - static_cast<long long>(buckets.size()) + 1);
+        for (long long n = from; n <= number; n++) {
+            Bucket& bucket = buckets[slotOf(n)];
+            windowPnl -= bucket.pnl;
+            bucket = Bucket{n, Notional()};
+        }
+        latest = number;
+    }
+
+public:
+    /**
+     * @param bucketDurationMs 每個桶的時長（毫秒）
+     * @param bucketCount 保留的桶數，窗口長度 = 時長 × 桶數
+     */
+    PnlRollup(long long bucketDurationMs, size_t bucketCount)
+        : bucketMs(bucketDurationMs)
+        , buckets(bucketCount, Bucket{-1, Notional()})
+        , latest(-1) {
+        if (bucketDurationMs <= 0 || bucketCount == 0) {
+            throw std::runtime_error("PnL rollup requires a positive bucket duration and count");
+        }
+    }
+
+    void add(long long timeMs, Notional pnl) {
+        long long number = timeMs / bucketMs;
+        advanceTo(number);
+        // 早於窗口的亂序記錄不計入時間桶
+        if (number <= latest - static_cast<long long>(buckets.size())) return;
+
+        Bucket& bucket = buckets[slotOf(number)];
+        bucket.pnl += pnl;
+        windowPnl += pnl;
+    }
+
+    /**
+     * @brief 截至 nowMs 的窗口盈虧總和（扣除已過期但尚未被覆蓋的桶）
+     */
+    Notional windowTotal(long long nowMs) const {
+        long long oldestValid = nowMs / bucketMs - static_cast<long long>(buckets.size()) + 1;
+        Notional total = windowPnl;
+        long long firstStored = latest - static_cast<long long>(buckets.size()) + 1;
+        for (long long n = std::max(firstStored, 0LL); n < oldestValid && n <= latest; n++) {
+            const Bucket& bucket = buckets[slotOf(n)];
+            if (bucket.number == n) total -= bucket.pnl;
+        }
+        return total;
+    }
+};
+
+/**
+ * @brief 單一網格線的已實現盈虧，存放在網格窗口的槽位中，網格線移出窗口時隨之清除
+ */
+struct LevelPnl {
+    Notional realized;
+    uint32_t closingSells;  // 在該網格線平倉的賣出筆數
+};
+
+/**
+ * @brief 增量已實現盈虧帳本
+ *
+ * 每筆平倉以O(1)更新累計總額、獲利筆數，以及按分鐘、小時、天彙總的環形緩衝區，
+ * 佔用的記憶體固定，與累計交易筆數無關；統計查詢只讀取這些匯總值。
+ * 各網格線的盈虧不在帳本中，由網格窗口的槽位（LevelPnl）保存。
+ */
+class PnlLedger {
+private:
+    Notional totalPnl;
+    uint64_t trades;
+    uint64_t winners;
+    PnlRollup minutes;
+    PnlRollup hours;
+    PnlRollup days;
+
+public:
+    PnlLedger()
+        : trades(0)
+        , winners(0)
+        , minutes(60 * 1000LL, 60)
+        , hours(60 * 60 * 1000LL, 24)
+        , days(24 * 60 * 60 * 1000LL, 30) {}
+
+    /**
+     * @brief 記錄一筆平倉
+     * @param pnl 已實現盈虧
+     * @param timeMs 成交時間（毫秒）
+     */
+    void record(Notional pnl, long long timeMs) {
+        totalPnl += pnl;
+        if (pnl > Notional()) winners++;
+        trades++;
+
+        minutes.add(timeMs, pnl);
+        hours.add(timeMs, pnl);
+        days.add(timeMs, pnl);
+    }
+
+    Notional total() const { return totalPnl; }
+    uint64_t tradeCount() const { return trades; }
+    uint64_t winningTrades() const { return winners; }
+
+    // 最近一小時、一天、三十天的已實現盈虧
+    Notional lastHour(long long nowMs) const { return minutes.windowTotal(nowMs); }
+    Notional lastDay(long long nowMs) const { return hours.windowTotal(nowMs); }
+    Notional last30Days(long long nowMs) const { return days.windowTotal(nowMs); }
+};
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+/**
+ * @brief 自適應輪詢間隔
+ *
+ * 依價格到最近未觸發網格線的距離與近期波動率估算觸及所需時間，
+ * 價格遠離網格線時拉長間隔、接近時縮短，並限制在配置範圍內。
+ * 以布朗運動近似：走完距離 d 的時間約為 (d / 每秒波動)^2。
+ */
+class AdaptivePollScheduler {
+private:
+    using Clock = std::chrono::steady_clock;
+
+    long long minIntervalMs;
+    long long maxIntervalMs;
+    long long defaultIntervalMs;
+    double safetyFactor;       // 預估觸及時間的取用比例
+    long long nextIntervalMs;
+    double averageCycleMs;     // 實際輪詢週期的指數平均（含請求耗時）
+    Clock::time_point lastPoll;
+    bool hasLastPoll;
+
+public:
+    /**
+     * @param minMs 最短間隔
+     * @param maxMs 最長間隔
+     * @param defaultMs 缺少波動率時使用的間隔
+     * @param factor 預估觸及時間乘以此比例作為下一次間隔
+     */
+    AdaptivePollScheduler(long long minMs, long long maxMs, long long defaultMs, double factor = 0.25)
+        : minIntervalMs(minMs)
+        , maxIntervalMs(std::max(minMs, maxMs))
+        , defaultIntervalMs(std::clamp(defaultMs, minMs, std::max(minMs, maxMs)))
+        , safetyFactor(factor)
+        , nextIntervalMs(defaultIntervalMs)
+        , averageCycleMs(0)
+        , hasLastPoll(false) {}
+
+    // 熱重載時更新間隔範圍，下一次輪詢起生效
+    void setIntervals(long long minMs, long long maxMs, long long defaultMs, double factor) {
+        minIntervalMs = minMs;
+        maxIntervalMs = std::max(minMs, maxMs);
+        defaultIntervalMs = std::clamp(defaultMs, minMs, maxIntervalMs);
+        safetyFactor = factor;
+        nextIntervalMs = std::clamp(nextIntervalMs, minIntervalMs, maxIntervalMs);
+    }
+
+    /**
+     * @brief 記錄一次輪詢，計算下一次間隔
+     * @param distance 到最近未觸發網格線觸發區的價格距離
+     * @param volatilityPerBar 每根K線的價格波動（價格單位），未知時傳0
+     * @param barMs K線週期（毫秒）
+     * @return 下一次輪詢前應等待的毫秒數
+     */
+    long long onPoll(double distance, double volatilityPerBar, long long barMs) {
+        auto now = Clock::now();
+        if (hasLastPoll) {
+            double cycleMs = std::chrono::duration<double, std::milli>(now - lastPoll).count();
+            averageCycleMs = averageCycleMs == 0 ? cycleMs : averageCycleMs * 0.9 + cycleMs * 0.1;
+        }
+        lastPoll = now;
+        hasLastPoll = true;
+
+        if (volatilityPerBar <= 0 || barMs <= 0 || !std::isfinite(distance)) {
+            nextIntervalMs = defaultIntervalMs;
+            return nextIntervalMs;
+        }
+
+        double volatilityPerSecond = volatilityPerBar / std::sqrt(barMs / 1000.0);
+        double expectedSeconds = std::pow(std::max(0.0, distance) / volatilityPerSecond, 2);
+        double intervalMs = expectedSeconds * 1000.0 * safetyFactor;
+        nextIntervalMs = static_cast<long long>(
+            std::clamp(intervalMs, static_cast<double>(minIntervalMs), static_cast<double>(maxIntervalMs)));
+        return nextIntervalMs;
+    }
+
+    long long getNextIntervalMs() const { return nextIntervalMs; }
+
+    // 實際每分鐘輪詢次數
+    double pollsPerMinute() const {
+        return averageCycleMs > 0 ? 60000.0 / averageCycleMs : 0;
+    }
+};
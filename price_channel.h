@@ -0,0 +1,129 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "seqlock.h"
+#include "spsc_ring.h"
+
+/**
+ * @brief 標準化的價格事件（行情執行緒 -> 策略執行緒），定長且可直接複製
+ */
+struct PriceEvent {
+    uint32_t pair;        // 策略下標
+    uint64_t sequence;    // 該交易對的事件序號，從1連續遞增
+    double price;
+    double bidPrice;      // 未知時為0
+    double askPrice;      // 未知時為0
+    long long eventTime;  // 交易所事件時間（毫秒），未知時為0
+};
+
+/**
+ * @brief 行情執行緒到單一策略執行緒的價格通道
+ *
+ * 事件經 SpscRing 傳遞。開啟合併（conflation）時，若策略執行緒落後導致佇列已滿，
+ * 生產者不等待，改把事件寫入該交易對的最新值槽位；消費者每批只保留每個交易對最新的一筆，
+ * 並丟棄序號不大於已交付序號的事件，因此佇列與槽位之間的先後次序不影響結果。
+ * 關閉合併時佇列已滿則生產者讓出CPU等待，每筆事件都會依序交付。
+ */
+class PriceChannel {
+private:
+    static constexpr size_t NOT_IN_BATCH = std::numeric_limits<size_t>::max();
+
+    SpscRing<PriceEvent> ring;
+    bool conflate;
+    size_t pairCount;
+    std::unique_ptr<SeqlockSlot<PriceEvent>[]> latest;  // 交易對 -> 溢出時的最新事件
+    std::unique_ptr<std::atomic<bool>[]> pending;       // 交易對 -> 槽位是否有未取走的事件
+    std::atomic<bool> overflowed;                       // 是否有任何槽位待取
+
+    // 以下只由消費者使用
+    std::vector<uint64_t> delivered;   // 交易對 -> 已交付的最大序號
+    std::vector<size_t> batchIndex;    // 交易對 -> 在本批中的位置
+    std::vector<uint64_t> conflatedEvents;  // 交易對 -> 被合併或丟棄的事件數
+
+public:
+    /**
+     * @param capacity 佇列容量，必須是2的冪
+     * @param pairs 交易對總數（事件的 pair 欄位小於此值）
+     * @param conflation 佇列已滿時是否合併為每個交易對的最新事件
+     */
+    PriceChannel(size_t capacity, size_t pairs, bool conflation)
+        : ring(capacity)
+        , conflate(conflation)
+        , pairCount(pairs)
+        , latest(new SeqlockSlot<PriceEvent>[pairs])
+        , pending(new std::atomic<bool>[pairs])
+        , overflowed(false)
+        , delivered(pairs, 0)
+        , batchIndex(pairs, NOT_IN_BATCH)
+        , conflatedEvents(pairs, 0) {
+        for (size_t pair = 0; pair < pairs; pair++) {
+            pending[pair].store(false, std::memory_order_relaxed);
+        }
+    }
+
+    PriceChannel(const PriceChannel&) = delete;
+    PriceChannel& operator=(const PriceChannel&) = delete;
+
+    // 生產者：發布一筆事件；開啟合併時不會等待
+    void publish(const PriceEvent& event) {
+        if (ring.tryPush(event)) return;
+        if (conflate) {
+            latest[event.pair].publish(event);
+            pending[event.pair].store(true, std::memory_order_release);
+            overflowed.store(true, std::memory_order_release);
+            return;
+        }
+        while (!ring.tryPush(event)) {
+            std::this_thread::yield();
+        }
+    }
+
+    /**
+     * @brief 消費者：取出最多 maxBatch 筆事件放入 batch（原內容被丟棄）
+     * @return 本批事件數，0 表示沒有新事件
+     */
+    size_t consume(std::vector<PriceEvent>& batch, size_t maxBatch) {
+        batch.clear();
+        ring.popBatch([&](const PriceEvent& event) { accept(batch, event); }, maxBatch);
+        if (overflowed.load(std::memory_order_relaxed) && overflowed.exchange(false, std::memory_order_acquire)) {
+            for (size_t pair = 0; pair < pairCount; pair++) {
+                if (pending[pair].exchange(false, std::memory_order_acquire)) {
+                    accept(batch, latest[pair].read());
+                }
+            }
+        }
+        // 序號連續，與上次交付之間的缺口即被合併或丟棄的事件，包括在槽位中被覆蓋、從未進入佇列的事件
+        for (const PriceEvent& event : batch) {
+            batchIndex[event.pair] = NOT_IN_BATCH;
+            conflatedEvents[event.pair] += event.sequence - delivered[event.pair] - 1;
+            delivered[event.pair] = event.sequence;
+        }
+        return batch.size();
+    }
+
+    // 消費者：該交易對至今被合併或丟棄的事件數
+    uint64_t conflatedCount(size_t pair) const { return conflatedEvents[pair]; }
+
+private:
+    void accept(std::vector<PriceEvent>& batch, const PriceEvent& event) {
+        if (event.sequence <= delivered[event.pair]) {
+            return;
+        }
+        if (conflate) {
+            size_t& index = batchIndex[event.pair];
+            if (index != NOT_IN_BATCH) {
+                if (event.sequence > batch[index].sequence) {
+                    batch[index] = event;
+                }
+                return;
+            }
+            index = batch.size();
+        }
+        batch.push_back(event);
+    }
+};
@@ -0,0 +1,269 @@
+#pragma once
+
+#include <curl/curl.h>
+#include <nlohmann/json.hpp>
+#include <poll.h>
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief 推送行情更新
+ */
+struct PriceUpdate {
+    std::string symbol;   // 交易對名稱（大寫）
+    double price;         // 最新成交價（bookTicker時為買賣中間價）
+    double bidPrice;      // 最優買價，未知時為0
+    double askPrice;      // 最優賣價，未知時為0
+    long long eventTime;  // 交易所事件時間（毫秒），未知時為0
+
+    PriceUpdate() : price(0), bidPrice(0), askPrice(0), eventTime(0) {}
+};
+
+/**
+ * @brief Binance WebSocket行情流
+ *
+ * 訂閱 trade、bookTicker 或 depth（增量深度）流，每收到一筆更新即回調。
+ * 斷線後以指數退避自動重連並重新訂閱。
+ * 需要啟用 WebSocket 支援的 libcurl（7.86+）。
+ */
+class PriceStream {
+public:
+    using UpdateHandler = std::function<void(const PriceUpdate&)>;
+    using DepthHandler = std::function<void(const nlohmann::json&)>;
+    using ConnectHandler = std::function<void()>;
+
+private:
+    CURL* curl;
+    std::string url;
+    std::string streamType;             // "trade"、"bookTicker" 或 "depth"
+    std::vector<std::string> streams;   // 例如 "ethusdt@bookTicker"
+    DepthHandler depthHandler;
+    ConnectHandler connectHandler;
+    std::string frameBuffer;            // 跨分片累積的訊息
+    PriceUpdate update;                 // 重用的更新物件
+    std::atomic<bool> running;
+    int subscribeId;
+
+    static constexpr int RECV_TIMEOUT_MS = 30000;
+    static constexpr int MAX_BACKOFF_MS = 30000;
+
+public:
+    /**
+     * @param baseUrl 串流根地址（例如："wss://stream.binance.com:9443"）
+     * @param type 串流類型："trade"、"bookTicker" 或 "depth"
+     */
+    PriceStream(const std::string& baseUrl, const std::string& type)
+        : curl(nullptr)
+        , url(baseUrl + "/ws")
+        , streamType(type)
+        , running(false)
+        , subscribeId(0) {
+        if (streamType != "trade" && streamType != "bookTicker" && streamType != "depth") {
+            throw std::runtime_error("Unsupported stream type: " + streamType);
+        }
+        frameBuffer.reserve(1024);
+    }
+
+    ~PriceStream() {
+        disconnect();
+    }
+
+    PriceStream(const PriceStream&) = delete;
+    PriceStream& operator=(const PriceStream&) = delete;
+
+    // 加入訂閱的交易對，重連時自動重新訂閱
+    void subscribe(const std::string& symbol) {
+        std::string name = symbol;
+        std::transform(name.begin(), name.end(), name.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        streams.push_back(name + (streamType == "depth" ? "@depth@100ms" : "@" + streamType));
+    }
+
+    // depth 流的增量事件回調
+    void onDepth(DepthHandler handler) { depthHandler = std::move(handler); }
+
+    // 每次（重新）連線並訂閱後回調，用於重建依賴連續性的狀態
+    void onConnect(ConnectHandler handler) { connectHandler = std::move(handler); }
+
+    /**
+     * @brief 阻塞執行接收循環，直到 stop() 被呼叫
+     * @param onUpdate 每筆行情更新的回調
+     */
+    void run(const UpdateHandler& onUpdate) {
+        running = true;
+        int backoffMs = 500;
+
+        while (running) {
+            try {
+                connect();
+                sendSubscribe();
+                backoffMs = 500;
+                if (connectHandler) connectHandler();
+                receiveLoop(onUpdate);
+            } catch (const std::runtime_error& e) {
+                std::cerr << "Price stream error: " << e.what() << std::endl;
+            }
+            disconnect();
+
+            if (!running) break;
+            std::cerr << "Reconnecting price stream in " << backoffMs << " ms" << std::endl;
+            std::this_thread::sleep_for(std::chrono::milliseconds(backoffMs));
+            backoffMs = std::min(backoffMs * 2, MAX_BACKOFF_MS);
+        }
+    }
+
+    void stop() { running = false; }
+
+private:
+    void connect() {
+        curl = curl_easy_init();
+        if (!curl) {
+            throw std::runtime_error("cURL init failed");
+        }
+        curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+        curl_easy_setopt(curl, CURLOPT_CONNECT_ONLY, 2L);  // WebSocket模式
+        curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+        curl_easy_setopt(curl, CURLOPT_TCP_NODELAY, 1L);
+        curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+        curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS, 5000L);
+
+        CURLcode res = curl_easy_perform(curl);
+        if (res != CURLE_OK) {
+            throw std::runtime_error(std::string("WebSocket connect failed: ") + curl_easy_strerror(res));
+        }
+        std::cout << "Price stream connected: " << url << std::endl;
+    }
+
+    void disconnect() {
+        if (curl) {
+            curl_easy_cleanup(curl);
+            curl = nullptr;
+        }
+        frameBuffer.clear();
+    }
+
+    void sendSubscribe() {
+        nlohmann::json request = {
+            {"method", "SUBSCRIBE"},
+            {"params", streams},
+            {"id", ++subscribeId}
+        };
+        std::string payload = request.dump();
+
+        size_t offset = 0;
+        while (offset < payload.size()) {
+            size_t sent = 0;
+            CURLcode res = curl_ws_send(curl, payload.data() + offset, payload.size() - offset,
+                                        &sent, 0, CURLWS_TEXT);
+            if (res == CURLE_AGAIN) {
+                waitSocket(POLLOUT, 1000);
+                continue;
+            }
+            if (res != CURLE_OK) {
+                throw std::runtime_error(std::string("WebSocket send failed: ") + curl_easy_strerror(res));
+            }
+            offset += sent;
+        }
+    }
+
+    // 等待套接字可讀或可寫，回傳是否就緒
+    bool waitSocket(short events, int timeoutMs) {
+        curl_socket_t sock = CURL_SOCKET_BAD;
+        curl_easy_getinfo(curl, CURLINFO_ACTIVESOCKET, &sock);
+        if (sock == CURL_SOCKET_BAD) {
+            throw std::runtime_error("WebSocket socket closed");
+        }
+        pollfd pfd{sock, events, 0};
+        return ::poll(&pfd, 1, timeoutMs) > 0;
+    }
+
+    void receiveLoop(const UpdateHandler& onUpdate) {
+        char chunk[4096];
+        auto lastData = std::chrono::steady_clock::now();
+
+        while (running) {
+            size_t received = 0;
+#if LIBCURL_VERSION_NUM >= 0x080000
+            const curl_ws_frame* meta = nullptr;
+#else
+            curl_ws_frame* meta = nullptr;  // 8.0之前的簽名不帶const
+#endif
+            CURLcode res = curl_ws_recv(curl, chunk, sizeof(chunk), &received, &meta);
+
+            if (res == CURLE_AGAIN) {
+                if (!waitSocket(POLLIN, 1000)) {
+                    auto idle = std::chrono::steady_clock::now() - lastData;
+                    if (idle > std::chrono::milliseconds(RECV_TIMEOUT_MS)) {
+                        throw std::runtime_error("WebSocket receive timeout");
+                    }
+                }
+                continue;
+            }
+            if (res != CURLE_OK) {
+                throw std::runtime_error(std::string("WebSocket receive failed: ") + curl_easy_strerror(res));
+            }
+            lastData = std::chrono::steady_clock::now();
+
+            if (meta->flags & CURLWS_CLOSE) {
+                throw std::runtime_error("WebSocket closed by server");
+            }
+            if (!(meta->flags & (CURLWS_TEXT | CURLWS_BINARY | CURLWS_CONT))) {
+                continue;  // ping/pong由libcurl自動處理
+            }
+
+            frameBuffer.append(chunk, received);
+            if (meta->bytesleft == 0 && !(meta->flags & CURLWS_CONT)) {
+                if (parseMessage(frameBuffer)) {
+                    onUpdate(update);
+                }
+                frameBuffer.clear();
+            }
+        }
+    }
+
+    /**
+     * @brief 解析 trade / bookTicker 訊息到 update
+     * @return 是否為行情更新（訂閱回覆等訊息回傳false）
+     */
+    bool parseMessage(const std::string& message) {
+        nlohmann::json data = nlohmann::json::parse(message, nullptr, false);
+        if (data.is_discarded() || !data.is_object() || !data.contains("s")) {
+            return false;
+        }
+        if (data.contains("U") && data.contains("u")) {
+            // depthUpdate: {"e":"depthUpdate","E":..,"s":..,"U":..,"u":..,"b":[..],"a":[..]}
+            if (depthHandler) depthHandler(data);
+            return false;
+        }
+
+        try {
+            update.symbol = data["s"].get<std::string>();
+            if (data.contains("b") && data.contains("a")) {
+                // bookTicker: {"u":..,"s":..,"b":"bid","B":..,"a":"ask","A":..}
+                update.bidPrice = std::stod(data["b"].get<std::string>());
+                update.askPrice = std::stod(data["a"].get<std::string>());
+                update.price = (update.bidPrice + update.askPrice) / 2;
+                update.eventTime = data.value("E", 0LL);
+            } else if (data.contains("p")) {
+                // trade: {"e":"trade","E":..,"s":..,"p":"price",..}
+                update.price = std::stod(data["p"].get<std::string>());
+                update.bidPrice = 0;
+                update.askPrice = 0;
+                update.eventTime = data.value("E", 0LL);
+            } else {
+                return false;
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "Malformed stream message: " << e.what() << std::endl;
+            return false;
+        }
+        return true;
+    }
+};
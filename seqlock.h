@@ -0,0 +1,67 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * @brief 單寫多讀的順序鎖槽位
+ *
+ * 寫入端（唯一擁有者）不加鎖、不等待：序號改為奇數、寫入資料、序號改為偶數；
+ * 讀取端在序號為奇數或前後不一致時重試，讀到的一定是某一次完整的發布。
+ * 資料以原子字組保存，讀寫並行時沒有資料競爭。
+ * 槽位獨佔快取行，多個寫入端的槽位放在一起也不會偽共享。
+ */
+template <typename T>
+class alignas(64) SeqlockSlot {
+    static_assert(std::is_trivially_copyable<T>::value, "SeqlockSlot requires a trivially copyable type");
+
+private:
+    static constexpr size_t WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    std::atomic<uint64_t> sequence;
+    std::atomic<uint64_t> words[WORDS];
+
+public:
+    SeqlockSlot()
+        : sequence(0) {
+        for (auto& word : words) {
+            word.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    SeqlockSlot(const SeqlockSlot&) = delete;
+    SeqlockSlot& operator=(const SeqlockSlot&) = delete;
+
+    // 只能由擁有者執行緒呼叫
+    void publish(const T& value) {
+        uint64_t buffer[WORDS] = {};
+        std::memcpy(buffer, &value, sizeof(T));
+
+        uint64_t seq = sequence.load(std::memory_order_relaxed);
+        sequence.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < WORDS; i++) {
+            words[i].store(buffer[i], std::memory_order_relaxed);
+        }
+        sequence.store(seq + 2, std::memory_order_release);
+    }
+
+    // 任意執行緒可呼叫，回傳最近一次完整發布的值（從未發布時為全零）
+    T read() const {
+        uint64_t buffer[WORDS];
+        while (true) {
+            uint64_t before = sequence.load(std::memory_order_acquire);
+            if (before & 1) continue;
+            for (size_t i = 0; i < WORDS; i++) {
+                buffer[i] = words[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence.load(std::memory_order_relaxed) == before) break;
+        }
+        T value;
+        std::memcpy(&value, buffer, sizeof(T));
+        return value;
+    }
+};
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+
+/**
+ * @brief 單生產者單消費者的無鎖環形佇列
+ *
+ * 容量取2的冪，以遮罩取代取模。讀寫索引各自獨佔快取行，
+ * 雙方各自快取對方的索引，只在快取值顯示滿或空時才讀取對方的原子變數，
+ * 減少快取行在核心之間往返。tryPush 與 popBatch 都在有限步內完成（wait-free）。
+ */
+template <typename T>
+class SpscRing {
+    static_assert(std::is_trivially_copyable<T>::value, "SpscRing requires a trivially copyable type");
+
+private:
+    static constexpr size_t CACHE_LINE = 64;
+
+    std::unique_ptr<T[]> slots;
+    size_t mask;
+
+    alignas(CACHE_LINE) std::atomic<size_t> tail;  // 生產者寫入
+    size_t cachedHead;                             // 生產者快取的讀取索引
+
+    alignas(CACHE_LINE) std::atomic<size_t> head;  // 消費者寫入
+    size_t cachedTail;                             // 消費者快取的寫入索引
+
+public:
+    /**
+     * @param capacity 容量，必須是2的冪
+     */
+    explicit SpscRing(size_t capacity)
+        : slots(new T[capacity])
+        , mask(capacity - 1)
+        , tail(0)
+        , cachedHead(0)
+        , head(0)
+        , cachedTail(0) {
+        if (capacity < 2 || (capacity & (capacity - 1)) != 0) {
+            throw std::runtime_error("SpscRing capacity must be a power of two");
+        }
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    size_t capacity() const { return mask + 1; }
+
+    // 生產者：寫入一項，佇列已滿時回傳 false
+    bool tryPush(const T& value) {
+        size_t position = tail.load(std::memory_order_relaxed);
+        if (position - cachedHead > mask) {
+            cachedHead = head.load(std::memory_order_acquire);
+            if (position - cachedHead > mask) return false;
+        }
+        slots[position & mask] = value;
+        tail.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief 消費者：最多取出 maxItems 項，依序交給 consume
+     * @return 取出的項數
+     */
+    template <typename Consumer>
+    size_t popBatch(Consumer&& consume, size_t maxItems) {
+        size_t position = head.load(std::memory_order_relaxed);
+        if (position == cachedTail) {
+            cachedTail = tail.load(std::memory_order_acquire);
+            if (position == cachedTail) return 0;
+        }
+        size_t count = std::min(cachedTail - position, maxItems);
+        for (size_t i = 0; i < count; i++) {
+            consume(slots[(position + i) & mask]);
+        }
+        head.store(position + count, std::memory_order_release);
+        return count;
+    }
+
+    // 近似的待處理項數（任一方呼叫皆可）
+    size_t sizeApprox() const {
+        return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+    }
+};
+
+/**
+ * @brief 消費者空閒時的退避：先自旋，再讓出CPU，最後短暫休眠
+ *
+ * 行情密集時停留在自旋階段，交接延遲最低；長時間無資料時退到休眠，不佔滿核心。
+ */
+class IdleBackoff {
+private:
+    unsigned idleRounds;
+    std::chrono::microseconds sleepTime;
+
+    static constexpr unsigned SPIN_ROUNDS = 64;
+    static constexpr unsigned YIELD_ROUNDS = 128;
+
+public:
+    /**
+     * @param sleep 退到休眠階段後每次休眠的時長
+     */
+    explicit IdleBackoff(std::chrono::microseconds sleep)
+        : idleRounds(0)
+        , sleepTime(sleep) {}
+
+    void idle() {
+        if (idleRounds < SPIN_ROUNDS) {
+            idleRounds++;
+        } else if (idleRounds < YIELD_ROUNDS) {
+            idleRounds++;
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(sleepTime);
+        }
+    }
+
+    void reset() { idleRounds = 0; }
+};
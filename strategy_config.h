@@ -0,0 +1,441 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "fixed_decimal.h"
+#include "grid_geometry.h"
+#include "volatility.h"
+
+enum class LogLevel { Debug, Info, Warn, Error };
+enum class MarketDataMode { Poll, Stream };
+enum class PriceTrigger { Last, Touch };
+enum class EngineMode { Pooled, Sharded };
+enum class ExecutionMode { Paper, Live };
+
+/**
+ * @brief 啟動時解析並校驗一次的策略配置
+ *
+ * 所有鍵在載入時轉成具體型別（枚舉、定點數），缺失或非法的值立即報錯；
+ * 執行期只讀取結構體欄位，不再查找 json。
+ */
+struct StrategyConfig {
+    // 網格數量上限：網格環形陣列有 2 × grid_count + 1 條網格線，每筆行情都按網格數量處理
+    static constexpr size_t MAX_GRID_COUNT = 10000;
+
+    // 交易對與精度
+    std::string tradingPair;
+    DecimalScale scale{2, 4};
+
+    // 網格
+    GridGeometry::Mode gridSpacingMode = GridGeometry::Mode::Arithmetic;
+    double gridSpacing = 0;       // 等差網格的價格間距
+    double gridSpacingRatio = 0;  // 等比網格的價格比例
+    int gridCount = 0;
+    bool infiniteGrid = true;
+    double lowerPriceLimit = 0;
+    double upperPriceLimit = 0;
+    double orderTriggerThreshold = 0;
+
+    // 訂單與風控
+    Quantity minOrderQuantity;
+    Notional initialInvestment;
+    Quantity maxPositionSize;
+    double maxDrawdownPercent = 0;
+    double maxLossPerTradePercent = 0;
+    double stopLossPercent = 0;
+    double takeProfitPercent = 0;
+    size_t orderArchiveSize = 0;
+
+    // 輸出
+    std::string logFilePath;
+    std::string dataFilePath;
+    std::string chartOutputPath;
+    LogLevel logLevel = LogLevel::Info;
+
+    // 行情
+    std::string restBaseUrl;
+    std::string wsBaseUrl;
+    MarketDataMode marketDataMode = MarketDataMode::Poll;
+    std::string streamType;
+    PriceTrigger priceTrigger = PriceTrigger::Last;
+    int depthSnapshotLimit = 0;
+
+    // 輪詢
+    long long updateIntervalSeconds = 0;
+    bool adaptivePolling = false;
+    long long minPollIntervalMs = 0;
+    long long maxPollIntervalMs = 0;
+    double pollSafetyFactor = 0;
+
+    // 波動率與動態網格間距
+    bool dynamicGridSpacing = false;
+    std::string volatilitySource;
+    std::string volatilityKlineInterval;
+    double volatilitySpacingMultiplier = 0;
+    double minGridSpacing = 0;
+    double ewmaLambda = 0;
+    int atrPeriod = 0;
+    std::vector<size_t> realizedVolatilityWindows;
+
+    // K線回補
+    bool klineBackfill = false;
+    size_t klineBackfillBars = 0;
+    size_t klineBackfillConcurrency = 0;
+    std::string klineCacheDir;
+
+    // 配置的網格間距：等差模式為價格間距，等比模式為比例
+    double configuredGridSpacing() const {
+        return gridSpacingMode == GridGeometry::Mode::Geometric ? gridSpacingRatio : gridSpacing;
+    }
+
+    /**
+     * @brief 解析並校驗配置
+     * @throws std::runtime_error 缺少必填鍵、型別錯誤或取值非法
+     */
+    static StrategyConfig fromJson(const nlohmann::json& json) {
+        StrategyConfig config;
+        config.tradingPair = required<std::string>(json, "trading_pair");
+        config.scale = DecimalScale(optional(json, "price_decimal_places", 2),
+                                    optional(json, "quantity_decimal_places", 4));
+
+        config.gridSpacingMode = GridGeometry::parseMode(optional<std::string>(json, "grid_spacing_mode", "arithmetic"));
+        config.gridSpacing = required<double>(json, "grid_spacing");
+        config.gridSpacingRatio = optional(json, "grid_spacing_ratio", 0.005);
+        config.gridCount = static_cast<int>(checkedCount(required<long long>(json, "grid_count"), "grid_count",
+                                                         MAX_GRID_COUNT));
+        config.infiniteGrid = optional(json, "infinite_grid", true);
+        config.lowerPriceLimit = optional(json, "lower_price_limit", 0.0);
+        config.upperPriceLimit = optional(json, "upper_price_limit", 0.0);
+        config.orderTriggerThreshold = optional(json, "order_trigger_threshold", 0.1);
+
+        config.minOrderQuantity = config.scale.toQuantity(required<double>(json, "min_order_quantity"));
+        config.initialInvestment = config.scale.toNotional(required<double>(json, "initial_investment"));
+        config.maxPositionSize = config.scale.toQuantity(required<double>(json, "max_position_size"));
+        config.maxDrawdownPercent = required<double>(json, "max_drawdown_percent");
+        config.maxLossPerTradePercent = required<double>(json, "max_loss_per_trade_percent");
+        config.stopLossPercent = optional(json, "stop_loss_percent", 0.05);
+        config.takeProfitPercent = optional(json, "take_profit_percent", 0.1);
+        config.orderArchiveSize = count(json, "order_archive_size", 10000, 10000000);
+
+        config.logFilePath = required<std::string>(json, "log_file_path");
+        config.dataFilePath = optional<std::string>(json, "data_file_path", "trading_data.txt");
+        config.chartOutputPath = optional<std::string>(json, "chart_output_path", "trading_chart.png");
+        config.logLevel = parseLogLevel(optional<std::string>(json, "log_level", "info"));
+
+        config.restBaseUrl = optional<std::string>(json, "rest_base_url", "https://api.binance.com");
+        config.wsBaseUrl = optional<std::string>(json, "ws_base_url", "wss://stream.binance.com:9443");
+        config.marketDataMode = parseMarketDataMode(optional<std::string>(json, "market_data_mode", "poll"));
+        config.streamType = optional<std::string>(json, "stream_type", "bookTicker");
+        config.priceTrigger = parsePriceTrigger(optional<std::string>(json, "price_trigger", "last"));
+        config.depthSnapshotLimit = optional(json, "depth_snapshot_limit", 1000);
+
+        config.updateIntervalSeconds = required<long long>(json, "update_interval_seconds");
+        config.adaptivePolling = optional(json, "adaptive_polling", false);
+        config.minPollIntervalMs = optional(json, "min_poll_interval_ms", 250LL);
+        config.maxPollIntervalMs = optional(json, "max_poll_interval_ms", 10000LL);
+        config.pollSafetyFactor = optional(json, "poll_safety_factor", 0.25);
+
+        config.dynamicGridSpacing = optional(json, "dynamic_grid_spacing", false);
+        config.volatilitySource = optional<std::string>(json, "volatility_source", "atr");
+        config.volatilityKlineInterval = optional<std::string>(json, "volatility_kline_interval", "1m");
+        config.volatilitySpacingMultiplier = optional(json, "volatility_spacing_multiplier", 0.01);
+        config.minGridSpacing = optional(json, "min_grid_spacing", 0.5);
+        config.ewmaLambda = optional(json, "ewma_lambda", 0.94);
+        config.atrPeriod = optional(json, "atr_period", 14);
+        config.realizedVolatilityWindows = counts(json, "realized_volatility_windows", {30, 240}, 1000000);
+
+        config.klineBackfill = optional(json, "kline_backfill", false);
+        config.klineBackfillBars = count(json, "kline_backfill_bars", 500, 1000000);
+        config.klineBackfillConcurrency = count(json, "kline_backfill_concurrency", 8, 64);
+        config.klineCacheDir = optional<std::string>(json, "kline_cache_dir", "kline_cache");
+
+        config.validate();
+        return config;
+    }
+
+    /**
+     * @brief 與新配置比較，回傳第一個變更後需要重啟才能生效的鍵，沒有則回傳 nullptr
+     *
+     * 交易對、精度、網格模式、行情連線、日誌文件與波動率估計器的參數
+     * 在啟動時固定；其餘鍵（網格間距與數量、價格上下限、風控、輪詢等）可熱重載。
+     */
+    const char* restartRequiredKey(const StrategyConfig& next) const {
+        if (next.tradingPair != tradingPair) return "trading_pair";
+        if (next.scale.getPriceDecimals() != scale.getPriceDecimals()) return "price_decimal_places";
+        if (next.scale.getQuantityDecimals() != scale.getQuantityDecimals()) return "quantity_decimal_places";
+        if (next.gridSpacingMode != gridSpacingMode) return "grid_spacing_mode";
+        if (next.initialInvestment != initialInvestment) return "initial_investment";
+        if (next.orderArchiveSize != orderArchiveSize) return "order_archive_size";
+        if (next.logFilePath != logFilePath) return "log_file_path";
+        if (next.restBaseUrl != restBaseUrl) return "rest_base_url";
+        if (next.wsBaseUrl != wsBaseUrl) return "ws_base_url";
+        if (next.marketDataMode != marketDataMode) return "market_data_mode";
+        if (next.streamType != streamType) return "stream_type";
+        if (next.depthSnapshotLimit != depthSnapshotLimit) return "depth_snapshot_limit";
+        if (next.volatilitySource != volatilitySource) return "volatility_source";
+        if (next.volatilityKlineInterval != volatilityKlineInterval) return "volatility_kline_interval";
+        if (next.ewmaLambda != ewmaLambda) return "ewma_lambda";
+        if (next.atrPeriod != atrPeriod) return "atr_period";
+        if (next.realizedVolatilityWindows != realizedVolatilityWindows) return "realized_volatility_windows";
+        return nullptr;
+    }
+
+private:
+    friend struct EngineConfig;  // 共用解析與校驗的輔助函數
+
+    template <typename T>
+    static T required(const nlohmann::json& json, const char* key) {
+        if (!json.contains(key)) {
+            throw std::runtime_error(std::string("Missing config key: ") + key);
+        }
+        return convert<T>(json, key);
+    }
+
+    template <typename T>
+    static T optional(const nlohmann::json& json, const char* key, const T& fallback) {
+        return json.contains(key) ? convert<T>(json, key) : fallback;
+    }
+
+    template <typename T>
+    static T convert(const nlohmann::json& json, const char* key) {
+        try {
+            return json.at(key).get<T>();
+        } catch (const nlohmann::json::exception&) {
+            throw std::runtime_error(std::string("Invalid type for config key: ") + key);
+        }
+    }
+
+    /**
+     * @brief 讀取非負整數鍵（容量、數量、窗口長度）
+     *
+     * 先以有號型別讀取再檢查範圍：直接讀成 size_t 時 -1 會被轉成極大值，
+     * 之後在 reserve() 等處才以 std::length_error 失敗，訊息也不指出是哪個鍵。
+     * @throws std::runtime_error 值為負數或大於 maximum
+     */
+    static size_t count(const nlohmann::json& json, const char* key, size_t fallback, size_t maximum) {
+        if (!json.contains(key)) return fallback;
+        return checkedCount(convert<long long>(json, key), key, maximum);
+    }
+
+    // 非負整數陣列，逐項檢查範圍
+    static std::vector<size_t> counts(const nlohmann::json& json, const char* key,
+                                      const std::vector<size_t>& fallback, size_t maximum) {
+        if (!json.contains(key)) return fallback;
+        std::vector<size_t> values;
+        for (long long value : convert<std::vector<long long>>(json, key)) {
+            values.push_back(checkedCount(value, key, maximum));
+        }
+        return values;
+    }
+
+    static size_t checkedCount(long long value, const char* key, size_t maximum) {
+        if (value < 0 || static_cast<unsigned long long>(value) > maximum) {
+            throw std::runtime_error(std::string("Invalid config: ") + key + " must be between 0 and "
+                                     + std::to_string(maximum));
+        }
+        return static_cast<size_t>(value);
+    }
+
+    static void check(bool condition, const char* message) {
+        if (!condition) {
+            throw std::runtime_error(std::string("Invalid config: ") + message);
+        }
+    }
+
+    void validate() const {
+        check(!tradingPair.empty(), "trading_pair must not be empty");
+        check(gridSpacing > 0, "grid_spacing must be positive");
+        check(gridSpacingRatio > 0, "grid_spacing_ratio must be positive");
+        // 比例低於 tick / 價格時相鄰網格線會取整到同一價格
+        check(gridSpacingMode != GridGeometry::Mode::Geometric || infiniteGrid || !(lowerPriceLimit > 0)
+                  || gridSpacingRatio * lowerPriceLimit >= scale.toDouble(Price::fromUnits(1)) * (1 - 1e-9),
+              "grid_spacing_ratio must be at least one price tick at lower_price_limit");
+        check(gridCount > 0, "grid_count must be positive");
+        check(infiniteGrid || (lowerPriceLimit > 0 && upperPriceLimit > lowerPriceLimit),
+              "lower_price_limit/upper_price_limit must satisfy 0 < lower < upper when infinite_grid is false");
+        check(orderTriggerThreshold >= 0 && orderTriggerThreshold < 0.5,
+              "order_trigger_threshold must be in [0, 0.5)");
+        check(minOrderQuantity > Quantity(), "min_order_quantity must be positive at quantity_decimal_places");
+        check(initialInvestment > Notional(), "initial_investment must be positive");
+        check(maxPositionSize >= minOrderQuantity, "max_position_size must be at least min_order_quantity");
+        check(maxDrawdownPercent > 0 && maxLossPerTradePercent > 0, "risk percentages must be positive");
+        check(updateIntervalSeconds >= 0, "update_interval_seconds must not be negative");
+        check(minPollIntervalMs > 0 && maxPollIntervalMs >= minPollIntervalMs,
+              "poll intervals must satisfy 0 < min_poll_interval_ms <= max_poll_interval_ms");
+        check(pollSafetyFactor > 0, "poll_safety_factor must be positive");
+        check(streamType == "trade" || streamType == "bookTicker" || streamType == "depth",
+              "stream_type must be trade, bookTicker or depth");
+        check(depthSnapshotLimit > 0, "depth_snapshot_limit must be positive");
+        check(volatilitySource == "atr" || volatilitySource == "ewma" || volatilitySource == "realized",
+              "volatility_source must be atr, ewma or realized");
+        check(ewmaLambda > 0 && ewmaLambda < 1, "ewma_lambda must be in (0, 1)");
+        check(atrPeriod > 0, "atr_period must be positive");
+        check(volatilitySource != "realized" || !realizedVolatilityWindows.empty(),
+              "realized volatility source requires realized_volatility_windows");
+        for (size_t window : realizedVolatilityWindows) {
+            check(window > 0, "realized_volatility_windows must be positive");
+        }
+        klineIntervalMs(volatilityKlineInterval);  // 非法週期時拋出
+        check(klineBackfillConcurrency > 0, "kline_backfill_concurrency must be positive");
+    }
+
+    static LogLevel parseLogLevel(const std::string& name) {
+        if (name == "debug") return LogLevel::Debug;
+        if (name == "info") return LogLevel::Info;
+        if (name == "warn") return LogLevel::Warn;
+        if (name == "error") return LogLevel::Error;
+        throw std::runtime_error("Invalid config: unknown log_level " + name);
+    }
+
+    static MarketDataMode parseMarketDataMode(const std::string& name) {
+        if (name == "poll") return MarketDataMode::Poll;
+        if (name == "stream") return MarketDataMode::Stream;
+        throw std::runtime_error("Invalid config: unknown market_data_mode " + name);
+    }
+
+    static PriceTrigger parsePriceTrigger(const std::string& name) {
+        if (name == "last") return PriceTrigger::Last;
+        if (name == "touch") return PriceTrigger::Touch;
+        throw std::runtime_error("Invalid config: unknown price_trigger " + name);
+    }
+};
+
+/**
+ * @brief 多交易對引擎的配置
+ *
+ * 配置文件可提供 "pairs" 陣列，每一項是一個交易對的配置，
+ * 未列出的鍵沿用頂層的值；沒有 "pairs" 時頂層本身即為唯一的交易對。
+ * 行情連線相關的鍵由所有交易對共用，必須一致；日誌與圖表文件必須各自獨立。
+ */
+struct EngineConfig {
+    // 交易對數量上限，與訂單ID中交易對編號的位數一致
+    static constexpr size_t MAX_PAIRS = 256;
+
+    std::vector<StrategyConfig> pairs;
+    size_t workerThreads = 0;  // 工作執行緒（分片）數，0 表示按CPU核心數
+    EngineMode engineMode = EngineMode::Pooled;
+    std::string shardLogDir;   // 分片模式下各分片輸出文件所在目錄
+    size_t priceRingCapacity = 0;      // 行情執行緒到工作執行緒的佇列容量（2的冪）
+    bool marketDataConflation = false;  // 工作執行緒落後時只處理每個交易對最新的行情
+    size_t orderQueueCapacity = 0;     // 訂單閘道請求佇列與各回報佇列的容量（2的冪）
+    ExecutionMode executionMode = ExecutionMode::Paper;
+    std::string apiKey;
+    std::string apiSecret;
+    long long recvWindowMs = 0;        // 簽名請求的有效時間窗口
+    long long orderStatusPollMs = 0;   // live 模式下每個訂單閘道查詢一筆掛單狀態的間隔
+
+    /**
+     * @brief 解析並校驗配置
+     * @throws std::runtime_error 任一交易對的配置非法，或交易對之間互相衝突
+     */
+    static EngineConfig fromJson(const nlohmann::json& json) {
+        EngineConfig config;
+        config.workerThreads = StrategyConfig::count(json, "worker_threads", 0, 1024);
+        config.engineMode = parseEngineMode(StrategyConfig::optional<std::string>(json, "engine_mode", "pooled"));
+        config.shardLogDir = StrategyConfig::optional<std::string>(json, "shard_log_dir", "shard_logs");
+        config.priceRingCapacity = StrategyConfig::count(json, "price_ring_capacity", 4096, size_t(1) << 24);
+        config.marketDataConflation = StrategyConfig::optional(json, "market_data_conflation", false);
+        StrategyConfig::check(config.priceRingCapacity >= 2 && (config.priceRingCapacity & (config.priceRingCapacity - 1)) == 0,
+                              "price_ring_capacity must be a power of two");
+        config.orderQueueCapacity = StrategyConfig::count(json, "order_queue_capacity", 4096, size_t(1) << 24);
+        StrategyConfig::check(config.orderQueueCapacity >= 2 && (config.orderQueueCapacity & (config.orderQueueCapacity - 1)) == 0,
+                              "order_queue_capacity must be a power of two");
+        config.executionMode = parseExecutionMode(StrategyConfig::optional<std::string>(json, "execution_mode", "paper"));
+        config.apiKey = StrategyConfig::optional<std::string>(json, "binance_api_key", "");
+        config.apiSecret = StrategyConfig::optional<std::string>(json, "binance_api_secret", "");
+        config.recvWindowMs = StrategyConfig::optional<long long>(json, "recv_window_ms", 5000);
+        StrategyConfig::check(config.recvWindowMs > 0 && config.recvWindowMs <= 60000,
+                              "recv_window_ms must be between 1 and 60000");
+        config.orderStatusPollMs = StrategyConfig::optional<long long>(json, "order_status_poll_ms", 200);
+        StrategyConfig::check(config.orderStatusPollMs >= 50 && config.orderStatusPollMs <= 60000,
+                              "order_status_poll_ms must be between 50 and 60000");
+        StrategyConfig::check(config.executionMode == ExecutionMode::Paper
+                              || (!config.apiKey.empty() && !config.apiSecret.empty()),
+                              "live execution_mode requires binance_api_key and binance_api_secret");
+
+        if (!json.contains("pairs")) {
+            config.pairs.push_back(StrategyConfig::fromJson(json));
+            return config;
+        }
+
+        const nlohmann::json& list = json.at("pairs");
+        StrategyConfig::check(list.is_array() && !list.empty(), "pairs must be a non-empty array");
+        nlohmann::json defaults = json;
+        defaults.erase("pairs");
+        for (size_t i = 0; i < list.size(); i++) {
+            StrategyConfig::check(list[i].is_object(), "pairs entries must be objects");
+            nlohmann::json merged = defaults;
+            merged.update(list[i]);
+            try {
+                config.pairs.push_back(StrategyConfig::fromJson(merged));
+            } catch (const std::runtime_error& error) {
+                throw std::runtime_error("pairs[" + std::to_string(i) + "]: " + error.what());
+            }
+        }
+        config.validate();
+        return config;
+    }
+
+    /**
+     * @brief 與新配置比較，回傳第一個需要重啟才能生效的鍵，沒有則回傳 nullptr
+     *
+     * 交易對列表、工作執行緒數與引擎模式在啟動時固定，各交易對再逐一比較。
+     */
+    const char* restartRequiredKey(const EngineConfig& next) const {
+        if (next.workerThreads != workerThreads) return "worker_threads";
+        if (next.engineMode != engineMode) return "engine_mode";
+        if (next.shardLogDir != shardLogDir) return "shard_log_dir";
+        if (next.priceRingCapacity != priceRingCapacity) return "price_ring_capacity";
+        if (next.marketDataConflation != marketDataConflation) return "market_data_conflation";
+        if (next.orderQueueCapacity != orderQueueCapacity) return "order_queue_capacity";
+        if (next.executionMode != executionMode) return "execution_mode";
+        if (next.apiKey != apiKey) return "binance_api_key";
+        if (next.apiSecret != apiSecret) return "binance_api_secret";
+        if (next.recvWindowMs != recvWindowMs) return "recv_window_ms";
+        if (next.orderStatusPollMs != orderStatusPollMs) return "order_status_poll_ms";
+        if (next.pairs.size() != pairs.size()) return "pairs";
+        for (size_t i = 0; i < pairs.size(); i++) {
+            const char* key = pairs[i].restartRequiredKey(next.pairs[i]);
+            if (key != nullptr) return key;
+        }
+        return nullptr;
+    }
+
+private:
+    static EngineMode parseEngineMode(const std::string& name) {
+        if (name == "pooled") return EngineMode::Pooled;
+        if (name == "sharded") return EngineMode::Sharded;
+        throw std::runtime_error("Invalid config: unknown engine_mode " + name);
+    }
+
+    static ExecutionMode parseExecutionMode(const std::string& name) {
+        if (name == "paper") return ExecutionMode::Paper;
+        if (name == "live") return ExecutionMode::Live;
+        throw std::runtime_error("Invalid config: unknown execution_mode " + name);
+    }
+
+    void validate() const {
+        StrategyConfig::check(pairs.size() <= MAX_PAIRS, "pairs supports at most 256 entries");
+
+        const StrategyConfig& first = pairs.front();
+        std::unordered_set<std::string> symbols;
+        std::unordered_set<std::string> files;
+        for (const StrategyConfig& pair : pairs) {
+            StrategyConfig::check(symbols.insert(pair.tradingPair).second, "trading_pair must be unique across pairs");
+            StrategyConfig::check(pair.restBaseUrl == first.restBaseUrl && pair.wsBaseUrl == first.wsBaseUrl,
+                                  "rest_base_url and ws_base_url must be the same for all pairs");
+            StrategyConfig::check(pair.marketDataMode == first.marketDataMode && pair.streamType == first.streamType,
+                                  "market_data_mode and stream_type must be the same for all pairs");
+            StrategyConfig::check(pair.depthSnapshotLimit == first.depthSnapshotLimit,
+                                  "depth_snapshot_limit must be the same for all pairs");
+            for (const std::string* path : {&pair.logFilePath, &pair.dataFilePath, &pair.chartOutputPath}) {
+                StrategyConfig::check(files.insert(*path).second,
+                                      "log_file_path, data_file_path and chart_output_path must be unique per pair");
+            }
+        }
+    }
+};
@@ -0,0 +1,169 @@
+// 幣安訂單客戶端測試：HMAC-SHA256 與 SignedQuery 的已知向量，以及對本機模擬交易所的下單、撤單、查詢往返
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../binance_order_client.h"
+#include "mock_exchange.h"
+
+namespace {
+
+// 幣安 API 文件中的簽名範例
+const char* DOC_SECRET = "NhqPtmdSJYdKjVHjA7PZj4Mge3R5YNiP1e3UZjInClVN65XAbvqqM6A7H5fATj0j";
+const char* DOC_QUERY = "symbol=LTCBTC&side=BUY&type=LIMIT&timeInForce=GTC&quantity=1&price=0.1"
+                        "&recvWindow=5000&timestamp=1499827319559";
+const char* DOC_SIGNATURE = "c8db56825ae71d6d79447849e617115f4a920fa2acdcab2b053c4b2838bd6b71";
+
+void testKnownVector() {
+    HmacSha256Signer signer(DOC_SECRET);
+    std::string query(DOC_QUERY);
+    char hex[HmacSha256Signer::HEX_LENGTH];
+    signer.sign(query.data(), query.size(), hex);
+    assert(std::string(hex, sizeof(hex)) == DOC_SIGNATURE);
+
+    // 同一簽名器重複使用結果不變
+    signer.sign(query.data(), query.size(), hex);
+    assert(std::string(hex, sizeof(hex)) == DOC_SIGNATURE);
+
+    // 前綴不參與簽名，數量與價格以定點數寫入
+    SignedQuery signedQuery;
+    std::string_view text = signedQuery.reset("/api/v3/order?")
+        .add("symbol", "LTCBTC")
+        .add("side", "BUY")
+        .add("type", "LIMIT")
+        .add("timeInForce", "GTC")
+        .addDecimal("quantity", 1, 0)
+        .addDecimal("price", 1, 1)
+        .add("recvWindow", 5000LL)
+        .add("timestamp", 1499827319559LL)
+        .sign(signer);
+    assert(text == std::string("/api/v3/order?") + DOC_QUERY + "&signature=" + DOC_SIGNATURE);
+
+    signedQuery.reset().addDecimal("price", 300050, 2).addDecimal("quantity", 5, 4).addDecimal("delta", -7, 3);
+    assert(signedQuery.view() == "price=3000.50&quantity=0.0005&delta=-0.007");
+}
+
+// 推進客戶端直到收到 count 筆回報或逾時
+void waitReplies(BinanceOrderClient& client, const std::vector<OrderReply>& replies, size_t count) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (replies.size() < count && std::chrono::steady_clock::now() < deadline) {
+        client.poll();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    assert(replies.size() == count);
+}
+
+OrderRequest request(uint64_t orderId, OrderAction action, Price price, Quantity quantity) {
+    return OrderRequest{orderId, orderId, price, quantity, 0, INVALID_POOL_HANDLE, action, OrderSide::Buy};
+}
+
+void testRoundTrip() {
+    MockExchange exchange("testkey", "testsecret");
+    BinanceOrderClient client(exchange.baseUrl(), "testkey", "testsecret", 5000);
+    DecimalScale scale(2, 4);
+    client.addMarket("ETHUSDT", scale);
+    std::vector<OrderReply> replies;
+    client.setReplyHandler([&replies](const OrderReply& reply) { replies.push_back(reply); });
+    client.syncClock();
+
+    OrderIdGenerator ids;
+    Price price = scale.toPrice(3000.5);
+    Quantity quantity = scale.toQuantity(0.01);
+
+    // 下單後撤單
+    uint64_t first = ids.next(0, 1);
+    client.send(request(first, OrderAction::New, price, quantity));
+    waitReplies(client, replies, 1);
+    assert(replies[0].orderId == first && replies[0].type == OrderReplyType::Accepted);
+    assert(replies[0].action == OrderAction::New);
+    assert(exchange.status(OrderIdGenerator::encode(first).c_str()) == "NEW");
+
+    client.send(request(first, OrderAction::Cancel, price, quantity));
+    waitReplies(client, replies, 2);
+    assert(replies[1].orderId == first && replies[1].type == OrderReplyType::Canceled);
+    assert(exchange.status(OrderIdGenerator::encode(first).c_str()) == "CANCELED");
+
+    // 撤單時訂單已成交：-2011 後查詢，按實際成交回報
+    uint64_t second = ids.next(0, 2);
+    client.send(request(second, OrderAction::New, price, quantity));
+    waitReplies(client, replies, 3);
+    exchange.fill(OrderIdGenerator::encode(second).c_str());
+    client.send(request(second, OrderAction::Cancel, price, quantity));
+    waitReplies(client, replies, 4);
+    assert(replies[3].orderId == second && replies[3].type == OrderReplyType::Filled);
+    assert(replies[3].action == OrderAction::Cancel);
+    assert(replies[3].price == price && replies[3].quantity == quantity);
+
+    // 下單回 503：訂單已建立，查詢後回報掛單中
+    uint64_t third = ids.next(0, 3);
+    exchange.failNextOrder();
+    client.send(request(third, OrderAction::New, price, quantity));
+    waitReplies(client, replies, 5);
+    assert(replies[4].orderId == third && replies[4].type == OrderReplyType::Accepted);
+
+    // 查詢不存在的訂單回報拒絕
+    uint64_t missing = ids.next(0, 4);
+    client.queryOrder(0, missing, OrderAction::New);
+    waitReplies(client, replies, 6);
+    assert(replies[5].orderId == missing && replies[5].type == OrderReplyType::Rejected);
+    assert(replies[5].errorCode == -2013);
+
+    // 部分成交後撤單：先回報已成交的部分，再回報撤銷
+    uint64_t partial = ids.next(0, 5);
+    client.send(request(partial, OrderAction::New, price, quantity));
+    waitReplies(client, replies, 7);
+    exchange.partialFill(OrderIdGenerator::encode(partial).c_str(), "0.0040");
+    client.send(request(partial, OrderAction::Cancel, price, quantity));
+    waitReplies(client, replies, 9);
+    assert(replies[7].orderId == partial && replies[7].type == OrderReplyType::PartiallyFilled);
+    assert(replies[7].action == OrderAction::Cancel);
+    assert(replies[7].quantity == scale.toQuantity(0.004) && replies[7].price == price);
+    assert(replies[8].orderId == partial && replies[8].type == OrderReplyType::Canceled);
+    assert(exchange.status(OrderIdGenerator::encode(partial).c_str()) == "CANCELED");
+
+    // 閘道輪詢掛單：部分成交時先回報成交再回報仍在掛單中，完全成交時回報 Filled
+    uint64_t resting = ids.next(0, 6);
+    client.send(request(resting, OrderAction::New, price, quantity));
+    waitReplies(client, replies, 10);
+    exchange.partialFill(OrderIdGenerator::encode(resting).c_str(), "0.0040");
+    client.send(request(resting, OrderAction::Query, Price(), Quantity()));
+    waitReplies(client, replies, 12);
+    assert(replies[10].type == OrderReplyType::PartiallyFilled && replies[10].action == OrderAction::Query);
+    assert(replies[10].quantity == scale.toQuantity(0.004));
+    assert(replies[11].type == OrderReplyType::Accepted && replies[11].action == OrderAction::Query);
+    exchange.fill(OrderIdGenerator::encode(resting).c_str());
+    client.send(request(resting, OrderAction::Query, Price(), Quantity()));
+    waitReplies(client, replies, 13);
+    assert(replies[12].type == OrderReplyType::Filled && replies[12].quantity == quantity);
+
+    assert(exchange.badSignatures == 0);
+    assert(exchange.newOrders == 5 && exchange.cancels == 3 && exchange.queries == 5);
+}
+
+void testWrongSecret() {
+    MockExchange exchange("testkey", "testsecret");
+    BinanceOrderClient client(exchange.baseUrl(), "testkey", "wrongsecret", 5000);
+    DecimalScale scale(2, 4);
+    client.addMarket("ETHUSDT", scale);
+    std::vector<OrderReply> replies;
+    client.setReplyHandler([&replies](const OrderReply& reply) { replies.push_back(reply); });
+    client.syncClock();
+
+    OrderIdGenerator ids;
+    client.send(request(ids.next(0, 1), OrderAction::New, scale.toPrice(3000), scale.toQuantity(0.01)));
+    waitReplies(client, replies, 1);
+    assert(replies[0].type == OrderReplyType::Rejected && replies[0].errorCode == -1022);
+    assert(exchange.badSignatures == 1);
+}
+
+}  // namespace
+
+int main() {
+    testKnownVector();
+    testRoundTrip();
+    testWrongSecret();
+    std::cout << "binance_order_client_test: OK" << std::endl;
+    return 0;
+}
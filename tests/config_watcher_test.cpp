@@ -0,0 +1,90 @@
+// 配置熱重載測試：文件變更後發布新快照，舊快照保持有效；非法內容與需要重啟的鍵變更不發布
+#include <cassert>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include "../config_watcher.h"
+
+namespace {
+
+nlohmann::json baseConfig(double gridSpacing) {
+    return nlohmann::json{
+        {"trading_pair", "ETHUSDT"},
+        {"grid_spacing", gridSpacing},
+        {"grid_count", 5},
+        {"min_order_quantity", 0.01},
+        {"initial_investment", 1000.0},
+        {"max_position_size", 10.0},
+        {"max_drawdown_percent", 0.1},
+        {"max_loss_per_trade_percent", 0.02},
+        {"update_interval_seconds", 1},
+        {"log_file_path", "trading_log.txt"}};
+}
+
+// 先寫入臨時文件再改名，與編輯器保存的方式相同
+void writeConfig(const std::filesystem::path& path, const std::string& content) {
+    std::filesystem::path temporary = path;
+    temporary += ".tmp";
+    std::ofstream(temporary) << content;
+    std::filesystem::rename(temporary, path);
+}
+
+// 等待快照指標改變，逾時回傳 nullptr
+const EngineConfig* waitForSwap(const ConfigWatcher& watcher, const EngineConfig* previous) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (std::chrono::steady_clock::now() < deadline) {
+        const EngineConfig* current = watcher.snapshot();
+        if (current != previous) return current;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return nullptr;
+}
+
+void testSnapshotSwap(const std::filesystem::path& path) {
+    writeConfig(path, baseConfig(1.0).dump());
+    ConfigWatcher watcher(path.string(), EngineConfig::fromJson(baseConfig(1.0)));
+    const EngineConfig* initial = watcher.snapshot();
+    assert(initial->pairs.at(0).gridSpacing == 1.0);
+    watcher.start();
+
+    writeConfig(path, baseConfig(2.0).dump());
+    const EngineConfig* reloaded = waitForSwap(watcher, initial);
+    assert(reloaded != nullptr);
+    assert(reloaded->pairs.at(0).gridSpacing == 2.0);
+    // 讀取端仍持有的舊快照不被釋放或修改
+    assert(initial->pairs.at(0).gridSpacing == 1.0);
+
+    // 非法內容與變更交易對都被拒絕；若曾被發布，之後的合法變更會因交易對不同而被拒絕
+    writeConfig(path, "{ not json");
+    nlohmann::json otherPair = baseConfig(3.0);
+    otherPair["trading_pair"] = "BTCUSDT";
+    writeConfig(path, otherPair.dump());
+    nlohmann::json badValue = baseConfig(-1.0);
+    writeConfig(path, badValue.dump());
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    assert(watcher.snapshot() == reloaded);
+
+    writeConfig(path, baseConfig(4.0).dump());
+    const EngineConfig* latest = waitForSwap(watcher, reloaded);
+    assert(latest != nullptr);
+    assert(latest->pairs.at(0).tradingPair == "ETHUSDT");
+    assert(latest->pairs.at(0).gridSpacing == 4.0);
+    assert(reloaded->pairs.at(0).gridSpacing == 2.0);
+    watcher.stop();
+}
+
+}  // namespace
+
+int main() {
+    std::filesystem::path directory = std::filesystem::temp_directory_path()
+        / ("config_watcher_test_" + std::to_string(getpid()));
+    std::filesystem::create_directories(directory);
+    testSnapshotSwap(directory / "config.json");
+    std::filesystem::remove_all(directory);
+    std::cout << "config_watcher_test: OK" << std::endl;
+    return 0;
+}
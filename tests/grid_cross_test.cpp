@@ -0,0 +1,91 @@
+// 網格穿越測試：一次跨過多條網格線時逐條產生穿越、觸發區邊界，以及可交易範圍的截斷
+#include <cassert>
+#include <iostream>
+#include <vector>
+#include "../grid_cross.h"
+#include "../grid_geometry.h"
+
+namespace {
+
+const GridGeometry GEOMETRY(GridGeometry::Mode::Arithmetic, 1.0, false, 0, 0);
+const double THRESHOLD = 0.1;
+const long long NO_MIN = -1000000;
+const long long NO_MAX = 1000000;
+
+std::vector<GridCross> detect(GridCrossDetector& detector, double price,
+                              long long minIndex = NO_MIN, long long maxIndex = NO_MAX) {
+    std::vector<GridCross> crosses;
+    detector.detect(price, price, GEOMETRY, THRESHOLD, minIndex, maxIndex, crosses);
+    return crosses;
+}
+
+void testMultiLevelCross() {
+    GridCrossDetector detector;
+    // 第一筆價格只記錄起點
+    assert(detect(detector, 3000.5).empty());
+
+    // 下跌跨過三條網格線：由高到低依序買入
+    std::vector<GridCross> crosses = detect(detector, 2997.5);
+    assert(crosses.size() == 3);
+    for (size_t i = 0; i < crosses.size(); i++) {
+        assert(crosses[i].isBuy);
+        assert(crosses[i].levelIndex == 3000 - static_cast<long long>(i));
+    }
+
+    // 上漲到 3001 的觸發區內：由低到高依序賣出
+    crosses = detect(detector, 3000.95);
+    assert(crosses.size() == 4);
+    for (size_t i = 0; i < crosses.size(); i++) {
+        assert(!crosses[i].isBuy);
+        assert(crosses[i].levelIndex == 2998 + static_cast<long long>(i));
+    }
+
+    // 在同一觸發區內波動不重複觸發
+    assert(detect(detector, 3000.92).empty());
+    assert(detect(detector, 3000.99).empty());
+}
+
+void testTriggerZone() {
+    GridCrossDetector detector;
+    detect(detector, 3000.5);
+    // 尚未進入 3000 的觸發區 [2999.9, 3000.1]
+    assert(detect(detector, 3000.15).empty());
+    std::vector<GridCross> crosses = detect(detector, 3000.05);
+    assert(crosses.size() == 1 && crosses[0].isBuy && crosses[0].levelIndex == 3000);
+}
+
+void testBidAskPrices() {
+    GridCrossDetector detector;
+    std::vector<GridCross> crosses;
+    detector.detect(3000.6, 3000.4, GEOMETRY, THRESHOLD, NO_MIN, NO_MAX, crosses);
+    // 賣一價跌到 2999.95 才觸發買入，買一價同時下跌不觸發賣出
+    detector.detect(2999.95, 2999.75, GEOMETRY, THRESHOLD, NO_MIN, NO_MAX, crosses);
+    assert(crosses.size() == 1 && crosses[0].isBuy && crosses[0].levelIndex == 3000);
+    // 買一價上漲到 3000.9 觸發 3001 的賣出，賣一價上漲不觸發買入
+    detector.detect(3001.1, 3000.9, GEOMETRY, THRESHOLD, NO_MIN, NO_MAX, crosses);
+    assert(crosses.size() == 2);
+    assert(!crosses[0].isBuy && crosses[0].levelIndex == 3000);
+    assert(!crosses[1].isBuy && crosses[1].levelIndex == 3001);
+}
+
+void testRangeClamp() {
+    GridCrossDetector detector;
+    detect(detector, 3010.5);
+    // 跌穿整個可交易範圍：只產生 [2995, 3005] 內的穿越
+    std::vector<GridCross> crosses = detect(detector, 2980.5, 2995, 3005);
+    assert(crosses.size() == 11);
+    assert(crosses.front().levelIndex == 3005 && crosses.back().levelIndex == 2995);
+    // 完全在範圍之外的移動不產生穿越
+    assert(detect(detector, 2970.5, 2995, 3005).empty());
+}
+
+}  // namespace
+
+int main() {
+    testMultiLevelCross();
+    testTriggerZone();
+    testBidAskPrices();
+    testRangeClamp();
+    std::cout << "grid_cross_test: OK" << std::endl;
+    return 0;
+}
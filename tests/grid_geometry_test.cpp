@@ -0,0 +1,157 @@
+// 網格幾何測試：價格與網格索引的往返換算、有限網格的邊界，以及等比網格在粗 tick 下的取整
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include "../fixed_decimal.h"
+#include "../grid_geometry.h"
+#include "../strategy_config.h"
+
+namespace {
+
+bool near(double a, double b, double tolerance = 1e-9) {
+    return std::fabs(a - b) <= tolerance * std::max(1.0, std::fabs(b));
+}
+
+void testArithmeticRoundTrip() {
+    GridGeometry geometry(GridGeometry::Mode::Arithmetic, 0.5, false, 0, 0);
+    for (long long k = -10; k <= 10000; k++) {
+        assert(geometry.indexOf(geometry.levelPrice(k)) == k);
+    }
+    assert(near(geometry.levelPrice(6001), 3000.5));
+    // 最接近的網格線
+    assert(geometry.indexOf(3000.74) == 6001);
+    assert(geometry.indexOf(3000.76) == 6002);
+}
+
+void testGeometricRoundTrip() {
+    GridGeometry geometry(GridGeometry::Mode::Geometric, 0.005, false, 0, 0);
+    for (long long k = -2000; k <= 2000; k++) {
+        assert(geometry.indexOf(geometry.levelPrice(k)) == k);
+    }
+    // 相鄰網格線的比例固定
+    for (long long k = 1000; k < 1010; k++) {
+        assert(near(geometry.levelPrice(k + 1) / geometry.levelPrice(k), 1.005));
+    }
+    // 取整到最小價格單位後仍能換算回同一條網格線
+    DecimalScale scale(2, 4);
+    for (long long k = 1000; k <= 2000; k++) {
+        Price level = scale.toPrice(geometry.levelPrice(k));
+        assert(geometry.indexOf(scale.toDouble(level)) == k);
+    }
+}
+
+void testBoundedClamping() {
+    GridGeometry arithmetic(GridGeometry::Mode::Arithmetic, 10, true, 1500, 2000);
+    assert(arithmetic.isBounded());
+    assert(arithmetic.minLevel() == 150);
+    assert(arithmetic.maxLevel() == 200);
+
+    // 價格上下限不在網格線上時向內取整
+    arithmetic.setBounds(true, 1505, 1995);
+    assert(arithmetic.minLevel() == 151);
+    assert(arithmetic.maxLevel() == 199);
+
+    GridGeometry geometric(GridGeometry::Mode::Geometric, 0.01, true, 1500, 2000);
+    assert(geometric.levelPrice(geometric.minLevel()) >= 1500 * (1 - 1e-12));
+    assert(geometric.levelPrice(geometric.minLevel() - 1) < 1500);
+    assert(geometric.levelPrice(geometric.maxLevel()) <= 2000 * (1 + 1e-12));
+    assert(geometric.levelPrice(geometric.maxLevel() + 1) > 2000);
+
+    // 改變間距後重新計算邊界
+    geometric.setSpacing(0.02);
+    assert(geometric.levelPrice(geometric.minLevel()) >= 1500 * (1 - 1e-12));
+    assert(geometric.levelPrice(geometric.maxLevel() + 1) > 2000);
+
+    bool threw = false;
+    try {
+        GridGeometry invalid(GridGeometry::Mode::Arithmetic, 10, true, 2000, 1500);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+}
+
+void testCoarseTick() {
+    // 價格約 1、tick 0.01：0.5% 的比例不到一個 tick，相鄰網格線取整到同一價格
+    DecimalScale scale(2, 4);
+    double tick = scale.toDouble(Price::fromUnits(1));
+    GridGeometry geometry(GridGeometry::Mode::Geometric, 0.005, false, 0, 0);
+    long long k = geometry.indexOf(1.0);
+    assert(scale.toPrice(geometry.levelPrice(k)) == scale.toPrice(geometry.levelPrice(k + 1)));
+    assert(geometry.minimumSpacing(tick, 1.0) > geometry.getSpacing());
+
+    // 提高到下限後相鄰網格線至少相差一個 tick
+    geometry.setSpacing(geometry.minimumSpacing(tick, 1.0));
+    k = geometry.indexOf(1.0);
+    for (long long i = k - 5; i < k + 5; i++) {
+        assert(scale.toPrice(geometry.levelPrice(i)) != scale.toPrice(geometry.levelPrice(i + 1)));
+    }
+
+    GridGeometry arithmetic(GridGeometry::Mode::Arithmetic, 1, false, 0, 0);
+    assert(arithmetic.minimumSpacing(tick, 1.0) == tick);
+}
+
+nlohmann::json baseConfig() {
+    return nlohmann::json{
+        {"trading_pair", "ADAUSDT"},
+        {"grid_spacing", 0.01},
+        {"grid_count", 5},
+        {"min_order_quantity", 10.0},
+        {"initial_investment", 1000.0},
+        {"max_position_size", 1000.0},
+        {"max_drawdown_percent", 0.1},
+        {"max_loss_per_trade_percent", 0.02},
+        {"update_interval_seconds", 1},
+        {"log_file_path", "trading_log.txt"},
+        {"data_file_path", "trading_data.txt"},
+        {"chart_output_path", "trading_chart.png"},
+        {"grid_spacing_mode", "geometric"},
+        {"infinite_grid", false},
+        {"lower_price_limit", 0.5},
+        {"upper_price_limit", 2.0},
+        {"price_decimal_places", 2}};
+}
+
+// 解析配置，回傳錯誤訊息，合法時為空
+std::string parseError(const nlohmann::json& json) {
+    try {
+        StrategyConfig::fromJson(json);
+    } catch (const std::runtime_error& error) {
+        return error.what();
+    }
+    return "";
+}
+
+void testGeometricRatioValidation() {
+    // 價格下限 0.5、tick 0.01：比例至少 2%
+    nlohmann::json json = baseConfig();
+    json["grid_spacing_ratio"] = 0.01;
+    assert(parseError(json).find("grid_spacing_ratio") != std::string::npos);
+    json["grid_spacing_ratio"] = 0.02;
+    assert(parseError(json).empty());
+
+    // 無限網格在執行時按當前價格提高比例，不在解析時拒絕
+    json["grid_spacing_ratio"] = 0.01;
+    json["infinite_grid"] = true;
+    assert(parseError(json).empty());
+
+    // 等差網格不受影響
+    json = baseConfig();
+    json["grid_spacing_ratio"] = 0.01;
+    json["grid_spacing_mode"] = "arithmetic";
+    assert(parseError(json).empty());
+}
+
+}  // namespace
+
+int main() {
+    testArithmeticRoundTrip();
+    testGeometricRoundTrip();
+    testBoundedClamping();
+    testCoarseTick();
+    testGeometricRatioValidation();
+    std::cout << "grid_geometry_test: OK" << std::endl;
+    return 0;
+}
@@ -0,0 +1,111 @@
+// 網格索引環形陣列測試：窗口平移時只移出離開窗口的槽位、跨越槽位邊界與負索引的回繞，以及改變容量
+#include <cassert>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+#include "../grid_levels.h"
+
+namespace {
+
+// 收集被移出的索引
+struct Evicted {
+    std::vector<long long> indexes;
+    std::vector<int> values;
+
+    void operator()(long long index, int& value) {
+        indexes.push_back(index);
+        values.push_back(value);
+    }
+};
+
+void testWindowShift() {
+    GridLevelRing<int> ring(5);
+    ring.setWindow(100, [](long long, int&) {});
+    for (long long k = 100; k <= 104; k++) {
+        ring.get(k) = static_cast<int>(k);
+    }
+    assert(ring.find(99) == nullptr && ring.find(105) == nullptr);
+    bool threw = false;
+    try {
+        ring.get(105);
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    assert(threw);
+
+    // 上移兩格：只移出 100 與 101，移入的 105、106 使用騰出的槽位且為空
+    Evicted evicted;
+    ring.setWindow(102, std::ref(evicted));
+    assert((evicted.indexes == std::vector<long long>{100, 101}));
+    assert((evicted.values == std::vector<int>{100, 101}));
+    assert(ring.find(105) == nullptr && ring.find(106) == nullptr);
+    for (long long k = 102; k <= 104; k++) {
+        assert(*ring.find(k) == k);
+    }
+    ring.get(106) = 106;
+
+    // 下移一格：移出最高的 106
+    evicted = Evicted();
+    ring.setWindow(101, std::ref(evicted));
+    assert((evicted.indexes == std::vector<long long>{106}));
+    assert(ring.find(101) == nullptr && *ring.find(104) == 104);
+
+    // 平移超過容量：全部移出
+    evicted = Evicted();
+    ring.setWindow(200, std::ref(evicted));
+    assert(evicted.indexes.size() == 3);
+    for (long long k = 200; k <= 204; k++) {
+        assert(ring.find(k) == nullptr);
+    }
+}
+
+void testNegativeWrap() {
+    GridLevelRing<int> ring(4);
+    ring.setWindow(-6, [](long long, int&) {});
+    for (long long k = -6; k <= -3; k++) {
+        ring.get(k) = static_cast<int>(k);
+    }
+    // 連續平移經過 0，每個索引仍存取到自己的值
+    for (long long first = -5; first <= 3; first++) {
+        Evicted evicted;
+        ring.setWindow(first, std::ref(evicted));
+        assert((evicted.indexes == std::vector<long long>{first - 1}));
+        ring.get(first + 3) = static_cast<int>(first + 3);
+        for (long long k = first; k <= first + 3; k++) {
+            assert(*ring.find(k) == k);
+        }
+    }
+}
+
+void testResize() {
+    GridLevelRing<int> ring(5);
+    ring.setWindow(10, [](long long, int&) {});
+    for (long long k = 10; k <= 14; k++) {
+        ring.get(k) = static_cast<int>(k);
+    }
+    // 縮小到 [12, 14]：12..14 保留，10、11 移出
+    Evicted evicted;
+    ring.resize(3, 12, std::ref(evicted));
+    assert(ring.capacity() == 3 && ring.firstIndex() == 12 && ring.lastIndex() == 14);
+    assert(evicted.indexes.size() == 2);
+    for (long long k = 12; k <= 14; k++) {
+        assert(*ring.find(k) == k);
+    }
+    // 擴大到 [11, 17]：原有值保留，新增網格線為空
+    ring.resize(7, 11, [](long long, int&) { assert(false); });
+    for (long long k = 12; k <= 14; k++) {
+        assert(*ring.find(k) == k);
+    }
+    assert(ring.find(11) == nullptr && ring.find(17) == nullptr);
+}
+
+}  // namespace
+
+int main() {
+    testWindowShift();
+    testNegativeWrap();
+    testResize();
+    std::cout << "grid_levels_test: OK" << std::endl;
+    return 0;
+}
@@ -0,0 +1,295 @@
+#pragma once
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <nlohmann/json.hpp>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../hmac_signer.h"
+
+/**
+ * @brief 測試用的本機幣安現貨訂單接口
+ *
+ * 在 127.0.0.1 的隨機埠上以 HTTP/1.1 提供 /api/v3/time 與 /api/v3/order（下單、撤單、查詢），
+ * 每筆訂單請求都檢查 X-MBX-APIKEY 並以相同密鑰重新計算 HMAC-SHA256 核對 signature。
+ * 撤單只接受掛單中（含部分成交）的訂單，否則回 -2011；查詢不存在的訂單回 -2013。
+ * fill() 把掛單標記為完全成交，partialFill() 標記為部分成交，failNextOrder() 讓下一筆下單在建立訂單後回 503（狀態未知），
+ * setLatency() 讓每個回應延遲固定時間，模擬網路往返。
+ * 每個連線一個執行緒，支援 keep-alive，連線在析構時統一關閉。
+ */
+class MockExchange {
+private:
+    struct MockOrder {
+        std::string symbol;
+        std::string side;
+        std::string price;
+        std::string quantity;
+        std::string executed;  // 累計成交數量
+        std::string status;
+    };
+
+    struct HttpRequest {
+        std::string method;
+        std::string path;
+        std::string query;
+        std::string apiKey;
+        std::string body;
+    };
+
+    std::string apiKey;
+    HmacSha256Signer signer;
+    std::mutex lock;  // 保護 orders、signer 與計數
+    std::map<std::string, MockOrder> orders;
+    int listenFd;
+    int port;
+    std::atomic<bool> running;
+    std::atomic<bool> failNext;
+    std::atomic<int> latencyMs;
+    std::thread acceptor;
+    std::mutex connectionsLock;
+    std::vector<int> connections;
+    std::vector<std::thread> handlers;
+
+public:
+    size_t badSignatures = 0;
+    size_t newOrders = 0;
+    size_t cancels = 0;
+    size_t queries = 0;
+
+    MockExchange(const std::string& key, const std::string& secret)
+        : apiKey(key)
+        , signer(secret)
+        , listenFd(socket(AF_INET, SOCK_STREAM, 0))
+        , port(0)
+        , running(true)
+        , failNext(false)
+        , latencyMs(0) {
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t length = sizeof(address);
+        if (listenFd < 0 || bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0
+            || listen(listenFd, SOMAXCONN) != 0
+            || getsockname(listenFd, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+            throw std::runtime_error("Mock exchange failed to listen");
+        }
+        port = ntohs(address.sin_port);
+        acceptor = std::thread([this]() { acceptLoop(); });
+    }
+
+    ~MockExchange() {
+        running = false;
+        shutdown(listenFd, SHUT_RDWR);
+        close(listenFd);
+        acceptor.join();
+        {
+            std::lock_guard<std::mutex> guard(connectionsLock);
+            for (int fd : connections) shutdown(fd, SHUT_RDWR);
+        }
+        for (std::thread& handler : handlers) handler.join();
+        // 連線在所有處理執行緒結束後才關閉，避免描述符被重用後誤關
+        for (int fd : connections) close(fd);
+    }
+
+    MockExchange(const MockExchange&) = delete;
+    MockExchange& operator=(const MockExchange&) = delete;
+
+    std::string baseUrl() const { return "http://127.0.0.1:" + std::to_string(port); }
+
+    // 把掛單標記為完全成交
+    void fill(const std::string& clientOrderId) {
+        std::lock_guard<std::mutex> guard(lock);
+        auto it = orders.find(clientOrderId);
+        if (it != orders.end() && isOpen(it->second)) {
+            it->second.status = "FILLED";
+            it->second.executed = it->second.quantity;
+        }
+    }
+
+    // 把掛單標記為部分成交，executed 為累計成交數量
+    void partialFill(const std::string& clientOrderId, const std::string& executed) {
+        std::lock_guard<std::mutex> guard(lock);
+        auto it = orders.find(clientOrderId);
+        if (it != orders.end() && isOpen(it->second)) {
+            it->second.status = "PARTIALLY_FILLED";
+            it->second.executed = executed;
+        }
+    }
+
+    void failNextOrder() { failNext = true; }
+
+    void setLatency(std::chrono::milliseconds latency) { latencyMs = static_cast<int>(latency.count()); }
+
+    std::string status(const std::string& clientOrderId) {
+        std::lock_guard<std::mutex> guard(lock);
+        auto it = orders.find(clientOrderId);
+        return it == orders.end() ? "" : it->second.status;
+    }
+
+private:
+    static bool isOpen(const MockOrder& order) {
+        return order.status == "NEW" || order.status == "PARTIALLY_FILLED";
+    }
+
+    void acceptLoop() {
+        while (running) {
+            int fd = accept(listenFd, nullptr, nullptr);
+            if (fd < 0) break;
+            std::lock_guard<std::mutex> guard(connectionsLock);
+            connections.push_back(fd);
+            handlers.emplace_back([this, fd]() { serve(fd); });
+        }
+    }
+
+    void serve(int fd) {
+        std::string buffer;
+        HttpRequest request;
+        while (readRequest(fd, buffer, request)) {
+            int status = 200;
+            nlohmann::json body = handle(request, status);
+            std::string payload = body.dump();
+            if (latencyMs > 0) std::this_thread::sleep_for(std::chrono::milliseconds(latencyMs.load()));
+            std::string response = "HTTP/1.1 " + std::to_string(status) + " X\r\nContent-Type: application/json\r\n"
+                                   "Content-Length: " + std::to_string(payload.size()) + "\r\n\r\n" + payload;
+            if (send(fd, response.data(), response.size(), MSG_NOSIGNAL) < 0) break;
+        }
+    }
+
+    static bool readRequest(int fd, std::string& buffer, HttpRequest& request) {
+        size_t headerEnd;
+        while ((headerEnd = buffer.find("\r\n\r\n")) == std::string::npos) {
+            if (!receive(fd, buffer)) return false;
+        }
+        std::string head = buffer.substr(0, headerEnd);
+        size_t contentLength = 0;
+        request = HttpRequest{};
+        size_t lineEnd = head.find("\r\n");
+        std::string requestLine = head.substr(0, lineEnd);
+        size_t space = requestLine.find(' ');
+        size_t target = requestLine.find(' ', space + 1);
+        request.method = requestLine.substr(0, space);
+        request.path = requestLine.substr(space + 1, target - space - 1);
+        size_t question = request.path.find('?');
+        if (question != std::string::npos) {
+            request.query = request.path.substr(question + 1);
+            request.path.resize(question);
+        }
+        for (size_t start = lineEnd; start != std::string::npos && start < head.size();) {
+            size_t end = head.find("\r\n", start + 2);
+            std::string line = head.substr(start + 2, end == std::string::npos ? std::string::npos : end - start - 2);
+            size_t colon = line.find(':');
+            if (colon != std::string::npos) {
+                std::string name = line.substr(0, colon);
+                std::string value = line.substr(line.find_first_not_of(' ', colon + 1));
+                for (char& c : name) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+                if (name == "content-length") contentLength = std::stoul(value);
+                if (name == "x-mbx-apikey") request.apiKey = value;
+            }
+            start = end;
+        }
+        while (buffer.size() < headerEnd + 4 + contentLength) {
+            if (!receive(fd, buffer)) return false;
+        }
+        request.body = buffer.substr(headerEnd + 4, contentLength);
+        buffer.erase(0, headerEnd + 4 + contentLength);
+        return true;
+    }
+
+    static bool receive(int fd, std::string& buffer) {
+        char chunk[4096];
+        ssize_t count = recv(fd, chunk, sizeof(chunk), 0);
+        if (count <= 0) return false;
+        buffer.append(chunk, static_cast<size_t>(count));
+        return true;
+    }
+
+    static std::map<std::string, std::string> parseParams(const std::string& text) {
+        std::map<std::string, std::string> params;
+        for (size_t start = 0; start < text.size();) {
+            size_t end = text.find('&', start);
+            if (end == std::string::npos) end = text.size();
+            size_t equals = text.find('=', start);
+            if (equals != std::string::npos && equals < end) {
+                params[text.substr(start, equals - start)] = text.substr(equals + 1, end - equals - 1);
+            }
+            start = end + 1;
+        }
+        return params;
+    }
+
+    static nlohmann::json error(int& status, int httpStatus, int code, const char* message) {
+        status = httpStatus;
+        return nlohmann::json{{"code", code}, {"msg", message}};
+    }
+
+    static nlohmann::json orderJson(const std::string& clientOrderId, const MockOrder& order) {
+        std::string quote = std::to_string(std::stod(order.price) * std::stod(order.executed));
+        return nlohmann::json{
+            {"symbol", order.symbol}, {"clientOrderId", clientOrderId}, {"price", order.price},
+            {"origQty", order.quantity}, {"executedQty", order.executed},
+            {"cummulativeQuoteQty", quote}, {"status", order.status}, {"side", order.side}};
+    }
+
+    nlohmann::json handle(const HttpRequest& request, int& status) {
+        if (request.path == "/api/v3/time") {
+            return nlohmann::json{{"serverTime", std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count()}};
+        }
+        if (request.path != "/api/v3/order") {
+            return error(status, 404, -1000, "Not found");
+        }
+
+        const std::string& signedText = request.method == "POST" ? request.body : request.query;
+        size_t signature = signedText.rfind("&signature=");
+        std::lock_guard<std::mutex> guard(lock);
+        if (request.apiKey != apiKey) {
+            return error(status, 401, -2015, "Invalid API-key, IP, or permissions for action.");
+        }
+        char expected[HmacSha256Signer::HEX_LENGTH];
+        if (signature == std::string::npos) {
+            badSignatures++;
+            return error(status, 400, -1102, "Mandatory parameter 'signature' was not sent.");
+        }
+        signer.sign(signedText.data(), signature, expected);
+        if (signedText.compare(signature + 11, std::string::npos, expected, sizeof(expected)) != 0) {
+            badSignatures++;
+            return error(status, 400, -1022, "Signature for this request is not valid.");
+        }
+
+        std::map<std::string, std::string> params = parseParams(signedText);
+        if (request.method == "POST") {
+            newOrders++;
+            const std::string& id = params["newClientOrderId"];
+            MockOrder& order = orders[id];
+            order = MockOrder{params["symbol"], params["side"], params["price"], params["quantity"], "0", "NEW"};
+            if (failNext.exchange(false)) {
+                return error(status, 503, -1000, "Unknown error, please check your request or try again later.");
+            }
+            return orderJson(id, order);
+        }
+        auto it = orders.find(params["origClientOrderId"]);
+        if (request.method == "DELETE") {
+            cancels++;
+            if (it == orders.end() || !isOpen(it->second)) {
+                return error(status, 400, -2011, "Unknown order sent.");
+            }
+            it->second.status = "CANCELED";
+            return orderJson(it->first, it->second);
+        }
+        queries++;
+        if (it == orders.end()) {
+            return error(status, 400, -2013, "Order does not exist.");
+        }
+        return orderJson(it->first, it->second);
+    }
+};
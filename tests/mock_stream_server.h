@@ -0,0 +1,203 @@
+#pragma once
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <openssl/evp.h>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief 測試用的本機 WebSocket 行情流，重播錄下的訊息
+ *
+ * 在 127.0.0.1 的隨機埠上接受 WebSocket 連線，讀取客戶端的 SUBSCRIBE 請求並回覆，
+ * 之後從上次中斷處依序送出訊息。dropAfter 大於0時每個連線送出該數量後主動斷線，用於驗證重連與重新訂閱；
+ * 全部送完後保持連線直到析構。每個連線一個執行緒，同一時間只重播給一個連線。
+ */
+class MockStreamServer {
+private:
+    static constexpr const char* WEBSOCKET_GUID = "258EAFA5-E914-47DA-95CA-C5AB0DC11B85";
+
+    std::vector<std::string> messages;
+    size_t dropAfter;
+    int listenFd;
+    int port;
+    std::atomic<bool> running;
+    std::atomic<size_t> nextMessage;
+    std::atomic<size_t> subscriptions;
+    std::thread acceptor;
+    std::mutex connectionsLock;
+    std::vector<int> connections;
+    std::vector<std::thread> handlers;
+
+public:
+    /**
+     * @param replay 依序送出的訊息（每筆一個文字幀）
+     * @param dropEvery 每個連線送出多少筆後斷線，0 表示不斷線
+     */
+    MockStreamServer(std::vector<std::string> replay, size_t dropEvery)
+        : messages(std::move(replay))
+        , dropAfter(dropEvery)
+        , listenFd(socket(AF_INET, SOCK_STREAM, 0))
+        , port(0)
+        , running(true)
+        , nextMessage(0)
+        , subscriptions(0) {
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t length = sizeof(address);
+        if (listenFd < 0 || bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0
+            || listen(listenFd, 4) != 0
+            || getsockname(listenFd, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+            throw std::runtime_error("Mock stream server failed to listen");
+        }
+        port = ntohs(address.sin_port);
+        acceptor = std::thread([this]() { acceptLoop(); });
+    }
+
+    ~MockStreamServer() {
+        running = false;
+        shutdown(listenFd, SHUT_RDWR);
+        close(listenFd);
+        acceptor.join();
+        {
+            std::lock_guard<std::mutex> guard(connectionsLock);
+            for (int fd : connections) shutdown(fd, SHUT_RDWR);
+        }
+        for (std::thread& handler : handlers) handler.join();
+        for (int fd : connections) close(fd);
+    }
+
+    MockStreamServer(const MockStreamServer&) = delete;
+    MockStreamServer& operator=(const MockStreamServer&) = delete;
+
+    std::string baseUrl() const { return "ws://127.0.0.1:" + std::to_string(port); }
+
+    // 已收到的 SUBSCRIBE 請求數（每次重連一個）
+    size_t subscribeCount() const { return subscriptions; }
+
+private:
+    void acceptLoop() {
+        while (running) {
+            int fd = accept(listenFd, nullptr, nullptr);
+            if (fd < 0) break;
+            std::lock_guard<std::mutex> guard(connectionsLock);
+            connections.push_back(fd);
+            handlers.emplace_back([this, fd]() { serve(fd); });
+        }
+    }
+
+    void serve(int fd) {
+        std::string buffer;
+        std::string subscribe;
+        if (!handshake(fd, buffer) || !readFrame(fd, buffer, subscribe)) {
+            shutdown(fd, SHUT_RDWR);
+            return;
+        }
+        size_t id = subscribe.find("\"id\":");
+        std::string reply = "{\"result\":null,\"id\":"
+                            + (id == std::string::npos ? "0" : subscribe.substr(id + 5, subscribe.find('}', id) - id - 5))
+                            + "}";
+        subscriptions++;
+        if (!sendFrame(fd, reply)) return;
+
+        size_t sent = 0;
+        while (running && nextMessage < messages.size()) {
+            if (dropAfter > 0 && sent == dropAfter) {
+                shutdown(fd, SHUT_RDWR);
+                return;
+            }
+            if (!sendFrame(fd, messages[nextMessage])) return;
+            nextMessage++;
+            sent++;
+        }
+        // 全部送完後保持連線，客戶端停止時自行斷開
+        char chunk[256];
+        while (running && recv(fd, chunk, sizeof(chunk), 0) > 0) {
+        }
+    }
+
+    static bool receive(int fd, std::string& buffer) {
+        char chunk[4096];
+        ssize_t count = recv(fd, chunk, sizeof(chunk), 0);
+        if (count <= 0) return false;
+        buffer.append(chunk, static_cast<size_t>(count));
+        return true;
+    }
+
+    static bool handshake(int fd, std::string& buffer) {
+        size_t end;
+        while ((end = buffer.find("\r\n\r\n")) == std::string::npos) {
+            if (!receive(fd, buffer)) return false;
+        }
+        std::string head = buffer.substr(0, end);
+        buffer.erase(0, end + 4);
+        std::string lower = head;
+        for (char& c : lower) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        size_t keyStart = lower.find("sec-websocket-key:");
+        if (keyStart == std::string::npos) return false;
+        keyStart = head.find_first_not_of(' ', keyStart + 18);
+        std::string key = head.substr(keyStart, head.find("\r\n", keyStart) - keyStart) + WEBSOCKET_GUID;
+
+        unsigned char digest[EVP_MAX_MD_SIZE];
+        unsigned int digestLength = 0;
+        EVP_Digest(key.data(), key.size(), digest, &digestLength, EVP_sha1(), nullptr);
+        unsigned char accept[64];
+        EVP_EncodeBlock(accept, digest, static_cast<int>(digestLength));
+        std::string response = std::string("HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\n"
+                                           "Connection: Upgrade\r\nSec-WebSocket-Accept: ")
+                               + reinterpret_cast<char*>(accept) + "\r\n\r\n";
+        return send(fd, response.data(), response.size(), MSG_NOSIGNAL) == static_cast<ssize_t>(response.size());
+    }
+
+    // 讀取一個客戶端幀（客戶端幀必定帶遮罩）
+    static bool readFrame(int fd, std::string& buffer, std::string& payload) {
+        while (buffer.size() < 2) {
+            if (!receive(fd, buffer)) return false;
+        }
+        size_t length = static_cast<unsigned char>(buffer[1]) & 0x7f;
+        size_t header = 2;
+        if (length == 126) header = 4;
+        if (length == 127) header = 10;
+        while (buffer.size() < header + 4) {
+            if (!receive(fd, buffer)) return false;
+        }
+        if (length >= 126) {
+            length = 0;
+            for (size_t i = 2; i < header; i++) length = length << 8 | static_cast<unsigned char>(buffer[i]);
+        }
+        while (buffer.size() < header + 4 + length) {
+            if (!receive(fd, buffer)) return false;
+        }
+        const char* mask = buffer.data() + header;
+        payload.assign(buffer, header + 4, length);
+        for (size_t i = 0; i < length; i++) payload[i] = static_cast<char>(payload[i] ^ mask[i % 4]);
+        buffer.erase(0, header + 4 + length);
+        return true;
+    }
+
+    static bool sendFrame(int fd, const std::string& payload) {
+        std::string frame(1, static_cast<char>(0x81));
+        size_t length = payload.size();
+        if (length < 126) {
+            frame += static_cast<char>(length);
+        } else if (length < 65536) {
+            frame += static_cast<char>(126);
+            frame += static_cast<char>(length >> 8);
+            frame += static_cast<char>(length & 0xff);
+        } else {
+            frame += static_cast<char>(127);
+            for (int shift = 56; shift >= 0; shift -= 8) frame += static_cast<char>((length >> shift) & 0xff);
+        }
+        frame += payload;
+        return send(fd, frame.data(), frame.size(), MSG_NOSIGNAL) == static_cast<ssize_t>(frame.size());
+    }
+};
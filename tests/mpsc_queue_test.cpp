@@ -0,0 +1,105 @@
+// 多生產者單消費者佇列測試：滿與空的邊界、序號跨輪的回繞，以及多個生產者同時寫入時各自的先後次序
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "../mpsc_queue.h"
+
+namespace {
+
+std::vector<int> popBatch(MpscQueue<int>& queue, size_t maxItems) {
+    std::vector<int> items;
+    queue.popBatch([&items](int value) { items.push_back(value); }, maxItems);
+    return items;
+}
+
+void testCapacity() {
+    for (size_t capacity : {0, 1, 5, 12}) {
+        bool threw = false;
+        try {
+            MpscQueue<int> queue(capacity);
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+    assert(MpscQueue<int>(16).capacity() == 16);
+}
+
+void testFullAndEmpty() {
+    MpscQueue<int> queue(4);
+    assert(popBatch(queue, 16).empty());
+
+    for (int i = 0; i < 4; i++) {
+        assert(queue.tryPush(i));
+    }
+    // 已滿：寫入失敗且不覆蓋未讀的項
+    assert(!queue.tryPush(99));
+
+    // 取出一項後恰好騰出一個位置
+    assert((popBatch(queue, 1) == std::vector<int>{0}));
+    assert(queue.tryPush(4));
+    assert(!queue.tryPush(5));
+    assert((popBatch(queue, 16) == std::vector<int>{1, 2, 3, 4}));
+    assert(popBatch(queue, 16).empty());
+}
+
+void testWrapAround() {
+    MpscQueue<int> queue(4);
+    int next = 0;
+    int expected = 0;
+    // 每輪寫入3項、取出3項，槽位序號逐輪推進並多次跨過槽位末端
+    for (int round = 0; round < 10; round++) {
+        for (int i = 0; i < 3; i++) {
+            assert(queue.tryPush(next++));
+        }
+        for (int value : popBatch(queue, 3)) {
+            assert(value == expected++);
+        }
+    }
+    assert(expected == next);
+    assert(popBatch(queue, 16).empty());
+}
+
+void testConcurrentProducers() {
+    constexpr uint64_t PRODUCERS = 4;
+    constexpr uint64_t PER_PRODUCER = 50000;
+    MpscQueue<uint64_t> queue(64);
+    std::vector<std::thread> producers;
+    for (uint64_t producer = 0; producer < PRODUCERS; producer++) {
+        producers.emplace_back([&queue, producer]() {
+            for (uint64_t i = 0; i < PER_PRODUCER; i++) {
+                while (!queue.tryPush(producer << 32 | i)) std::this_thread::yield();
+            }
+        });
+    }
+
+    // 不同生產者之間可交錯，同一生產者的項依寫入次序交付，且不遺漏、不重複
+    std::vector<uint64_t> expected(PRODUCERS, 0);
+    uint64_t received = 0;
+    while (received < PRODUCERS * PER_PRODUCER) {
+        size_t count = queue.popBatch([&expected, &received](uint64_t value) {
+            uint64_t producer = value >> 32;
+            assert(producer < PRODUCERS);
+            assert((value & 0xFFFFFFFF) == expected[producer]);
+            expected[producer]++;
+            received++;
+        }, 16);
+        if (count == 0) std::this_thread::yield();
+    }
+    for (std::thread& producer : producers) producer.join();
+    assert(queue.popBatch([](uint64_t) { assert(false); }, 16) == 0);
+}
+
+}  // namespace
+
+int main() {
+    testCapacity();
+    testFullAndEmpty();
+    testWrapAround();
+    testConcurrentProducers();
+    std::cout << "mpsc_queue_test: OK" << std::endl;
+    return 0;
+}
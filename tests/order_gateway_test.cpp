@@ -0,0 +1,204 @@
+// 訂單閘道測試：以腳本回應的傳輸層驗證回報送回所屬策略的佇列、累計成交換算為新增成交，以及掛單狀態輪詢
+#include <cassert>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <thread>
+#include <vector>
+#include "../order_gateway.h"
+
+namespace {
+
+const DecimalScale SCALE(2, 4);
+
+// 傳輸層回報的累計成交
+OrderReply fillReply(uint64_t orderId, OrderReplyType type, OrderAction action, double quantity, double price) {
+    OrderReply reply = OrderReply::make(orderId, type, action);
+    reply.quantity = SCALE.toQuantity(quantity);
+    reply.amount = SCALE.toPrice(price) * reply.quantity;
+    return reply;
+}
+
+/**
+ * @brief 以腳本回應的傳輸層：每收到一筆請求，按 (訂單ID, 請求) 送出預先排好的回報
+ *
+ * 回報在閘道執行緒上同步送回，與 BinanceOrderClient 在 poll() 內回報的情形相同。
+ */
+class ScriptedTransport {
+private:
+    using Key = std::pair<uint64_t, OrderAction>;
+
+    OrderGateway& gateway;
+    std::map<Key, std::vector<std::vector<OrderReply>>> script;  // 同一鍵的多筆請求依序取用
+
+public:
+    explicit ScriptedTransport(OrderGateway& target)
+        : gateway(target) {
+        gateway.setTransport([this](const OrderRequest& request) { send(request); }, []() { return size_t(0); });
+    }
+
+    void expect(uint64_t orderId, OrderAction action, std::vector<OrderReply> replies) {
+        script[Key(orderId, action)].push_back(std::move(replies));
+    }
+
+private:
+    void send(const OrderRequest& request) {
+        std::vector<std::vector<OrderReply>>& pending = script[Key(request.orderId, request.action)];
+        assert(!pending.empty());
+        std::vector<OrderReply> replies = std::move(pending.front());
+        pending.erase(pending.begin());
+        for (const OrderReply& reply : replies) gateway.onResponse(reply);
+    }
+};
+
+OrderRequest request(uint64_t orderId, OrderAction action, uint32_t strategy, OrderSide side = OrderSide::Buy) {
+    return OrderRequest{orderId, orderId, SCALE.toPrice(3000), SCALE.toQuantity(0.01), strategy,
+                        static_cast<PoolHandle>(orderId), action, side};
+}
+
+// 從策略 strategy 的回報佇列取出回報，直到累計 count 筆或逾時
+std::vector<OrderReply> drain(OrderGateway& gateway, uint32_t strategy, size_t count) {
+    std::vector<OrderReply> replies;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (replies.size() < count && std::chrono::steady_clock::now() < deadline) {
+        gateway.drainReplies(strategy, [&replies](const OrderReply& reply) { replies.push_back(reply); }, count);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    assert(replies.size() == count);
+    return replies;
+}
+
+// 回報路由：傳輸層只回填訂單ID，閘道按原請求送回所屬策略的佇列並補上句柄與方向
+void testReplyRouting() {
+    OrderGateway gateway(4, 3);
+    ScriptedTransport transport(gateway);
+    transport.expect(10, OrderAction::New, {OrderReply::make(10, OrderReplyType::Accepted, OrderAction::New)});
+    transport.expect(11, OrderAction::New, {fillReply(11, OrderReplyType::Filled, OrderAction::New, 0.01, 3000)});
+    transport.expect(12, OrderAction::New, {
+        OrderReply::make(12, OrderReplyType::Rejected, OrderAction::New, -2010, "Insufficient balance")});
+    // 回報佇列容量4：策略0 的6筆回報超出部分由閘道暫存，依序補送
+    for (uint64_t orderId = 20; orderId < 26; orderId++) {
+        transport.expect(orderId, OrderAction::New, {OrderReply::make(orderId, OrderReplyType::Accepted, OrderAction::New)});
+    }
+
+    gateway.start();
+    assert(gateway.submit(request(10, OrderAction::New, 2, OrderSide::Sell)));
+    assert(gateway.submit(request(11, OrderAction::New, 0)));
+    assert(gateway.submit(request(12, OrderAction::New, 1)));
+
+    std::vector<OrderReply> replies = drain(gateway, 2, 1);
+    assert(replies[0].orderId == 10 && replies[0].strategy == 2);
+    assert(replies[0].handle == 10 && replies[0].side == OrderSide::Sell);
+    replies = drain(gateway, 1, 1);
+    assert(replies[0].orderId == 12 && replies[0].strategy == 1 && replies[0].type == OrderReplyType::Rejected);
+    replies = drain(gateway, 0, 1);
+    assert(replies[0].orderId == 11 && replies[0].strategy == 0 && replies[0].type == OrderReplyType::Filled);
+
+    for (uint64_t orderId = 20; orderId < 26; orderId++) {
+        while (!gateway.submit(request(orderId, OrderAction::New, 0))) std::this_thread::yield();
+    }
+    replies = drain(gateway, 0, 6);
+    for (size_t i = 0; i < replies.size(); i++) {
+        assert(replies[i].orderId == 20 + i && replies[i].strategy == 0);
+    }
+    // 其他策略的佇列沒有收到任何回報
+    for (uint32_t strategy : {1u, 2u}) {
+        assert(gateway.drainReplies(strategy, [](const OrderReply&) {}, 16) == 0);
+    }
+    gateway.stop();
+}
+
+void testFillDeltas() {
+    OrderGateway gateway(64, 1);
+    ScriptedTransport transport(gateway);
+
+    // 下單即部分成交，撤單時交易所再次回報同一累計成交：只記一次
+    transport.expect(1, OrderAction::New, {
+        fillReply(1, OrderReplyType::PartiallyFilled, OrderAction::New, 0.004, 3000.5),
+        OrderReply::make(1, OrderReplyType::Accepted, OrderAction::New)});
+    transport.expect(1, OrderAction::Cancel, {
+        fillReply(1, OrderReplyType::PartiallyFilled, OrderAction::Cancel, 0.004, 3000.5),
+        OrderReply::make(1, OrderReplyType::Canceled, OrderAction::Cancel)});
+    // 部分成交後完全成交：Filled 只帶尚未記帳的部分與其均價
+    transport.expect(2, OrderAction::New, {
+        fillReply(2, OrderReplyType::PartiallyFilled, OrderAction::New, 0.004, 3000),
+        OrderReply::make(2, OrderReplyType::Accepted, OrderAction::New)});
+    transport.expect(2, OrderAction::Cancel, {
+        fillReply(2, OrderReplyType::Filled, OrderAction::Cancel, 0.01, 3001.2)});
+
+    gateway.start();
+    assert(gateway.submit(request(1, OrderAction::New, 0)));
+    assert(gateway.submit(request(1, OrderAction::Cancel, 0)));
+    std::vector<OrderReply> replies = drain(gateway, 0, 3);
+    assert(replies[0].type == OrderReplyType::PartiallyFilled);
+    assert(replies[0].quantity == SCALE.toQuantity(0.004) && replies[0].price == SCALE.toPrice(3000.5));
+    assert(replies[1].type == OrderReplyType::Accepted);
+    assert(replies[2].type == OrderReplyType::Canceled && replies[2].action == OrderAction::Cancel);
+
+    assert(gateway.submit(request(2, OrderAction::New, 0)));
+    assert(gateway.submit(request(2, OrderAction::Cancel, 0)));
+    replies = drain(gateway, 0, 3);
+    assert(replies[0].type == OrderReplyType::PartiallyFilled && replies[0].quantity == SCALE.toQuantity(0.004));
+    assert(replies[1].type == OrderReplyType::Accepted);
+    assert(replies[2].type == OrderReplyType::Filled);
+    assert(replies[2].quantity == SCALE.toQuantity(0.006));
+    // 累計 0.01 @ 3001.2 減去 0.004 @ 3000 -> 0.006 @ 3002
+    assert(replies[2].price == SCALE.toPrice(3002));
+    gateway.stop();
+}
+
+// 狀態輪詢：掛單期間的成交在輪詢時回報，訂單結束後不再查詢，之後的撤單由閘道直接回報
+void testStatusPolling() {
+    OrderGateway gateway(64, 1);
+    ScriptedTransport transport(gateway);
+    gateway.setStatusPolling(std::chrono::milliseconds(1));
+
+    transport.expect(3, OrderAction::New, {OrderReply::make(3, OrderReplyType::Accepted, OrderAction::New)});
+    transport.expect(3, OrderAction::Query, {OrderReply::make(3, OrderReplyType::Accepted, OrderAction::Query)});
+    transport.expect(3, OrderAction::Query, {
+        fillReply(3, OrderReplyType::PartiallyFilled, OrderAction::Query, 0.004, 3000),
+        OrderReply::make(3, OrderReplyType::Accepted, OrderAction::Query)});
+    transport.expect(3, OrderAction::Query, {fillReply(3, OrderReplyType::Filled, OrderAction::Query, 0.01, 3000)});
+    // 查詢失敗不結束訂單，下一次輪詢發現已被交易所撤銷
+    transport.expect(4, OrderAction::New, {OrderReply::make(4, OrderReplyType::Accepted, OrderAction::New)});
+    transport.expect(4, OrderAction::Query, {
+        OrderReply::make(4, OrderReplyType::Rejected, OrderAction::Query, -1003, "Too many requests")});
+    transport.expect(4, OrderAction::Query, {OrderReply::make(4, OrderReplyType::Canceled, OrderAction::Query)});
+
+    gateway.start();
+    assert(gateway.submit(request(3, OrderAction::New, 0)));
+    std::vector<OrderReply> replies = drain(gateway, 0, 5);
+    assert(replies[0].type == OrderReplyType::Accepted && replies[0].action == OrderAction::New);
+    assert(replies[1].type == OrderReplyType::Accepted && replies[1].action == OrderAction::Query);
+    assert(replies[2].type == OrderReplyType::PartiallyFilled && replies[2].quantity == SCALE.toQuantity(0.004));
+    assert(replies[3].type == OrderReplyType::Accepted);
+    assert(replies[4].type == OrderReplyType::Filled && replies[4].action == OrderAction::Query);
+    assert(replies[4].quantity == SCALE.toQuantity(0.006) && replies[4].price == SCALE.toPrice(3000));
+
+    // 已成交的訂單不再送往交易所撤銷（腳本沒有對應的撤單，送出即斷言失敗）
+    assert(gateway.submit(request(3, OrderAction::Cancel, 0)));
+    replies = drain(gateway, 0, 1);
+    assert(replies[0].type == OrderReplyType::Rejected && replies[0].action == OrderAction::Cancel);
+    assert(replies[0].handle == 3);
+
+    assert(gateway.submit(request(4, OrderAction::New, 0)));
+    replies = drain(gateway, 0, 3);
+    assert(replies[0].type == OrderReplyType::Accepted);
+    assert(replies[1].type == OrderReplyType::Rejected && replies[1].errorCode == -1003);
+    assert(replies[2].type == OrderReplyType::Canceled && replies[2].action == OrderAction::Query);
+
+    // 兩筆訂單都已結束，之後不再輪詢
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    gateway.stop();
+}
+
+}  // namespace
+
+int main() {
+    testReplyRouting();
+    testFillDeltas();
+    testStatusPolling();
+    std::cout << "order_gateway_test: OK" << std::endl;
+    return 0;
+}
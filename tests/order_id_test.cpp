@@ -0,0 +1,82 @@
+// 訂單ID測試：欄位的編碼與拆解、字串編碼的往返與排序，以及多執行緒同時生成時不重複
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../order_id.h"
+
+namespace {
+
+void testFields() {
+    OrderIdGenerator generator;
+    uint64_t first = generator.next(7, 1234);
+    uint64_t second = generator.next(255, -1);
+    OrderIdFields a = OrderIdGenerator::decode(first);
+    OrderIdFields b = OrderIdGenerator::decode(second);
+    assert(a.symbolId == 7 && a.levelBits == 1234);
+    // 負索引與超出12位的索引只保留低12位
+    assert(b.symbolId == 255 && b.levelBits == 0xFFF);
+    assert(OrderIdGenerator::decode(generator.next(1, 4096 + 5)).levelBits == 5);
+    // 同一秒內序號遞增，序號溢出時進位到秒數
+    assert(b.epochSeconds * 65536 + b.sequence == a.epochSeconds * 65536 + a.sequence + 1);
+    assert(second > first);
+}
+
+void testClientOrderId() {
+    OrderIdGenerator generator;
+    std::vector<uint64_t> ids = {0, 1, 63, 64, generator.next(3, 10), generator.next(3, 11), ~uint64_t(0)};
+    std::string previous;
+    for (uint64_t id : ids) {
+        ClientOrderId text = OrderIdGenerator::encode(id);
+        assert(std::strlen(text.c_str()) == ClientOrderId::LENGTH);
+        assert(OrderIdGenerator::parse(text.c_str()) == id);
+        // 字典序與數值順序一致
+        assert(previous < text.c_str());
+        previous = text.c_str();
+    }
+
+    for (const char* invalid : {"", "abc", "0123456789+", "0123456789AB", "0123456789 "}) {
+        bool threw = false;
+        try {
+            OrderIdGenerator::parse(invalid);
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+}
+
+void testConcurrentUnique() {
+    constexpr size_t THREADS = 4;
+    constexpr size_t PER_THREAD = 20000;
+    OrderIdGenerator generator;
+    std::vector<std::vector<uint64_t>> generated(THREADS);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < THREADS; t++) {
+        threads.emplace_back([&generator, &generated, t]() {
+            for (size_t i = 0; i < PER_THREAD; i++) {
+                // 所有執行緒使用同一交易對與網格線，唯一性只能來自計數器
+                generated[t].push_back(generator.next(1, 42));
+            }
+        });
+    }
+    for (std::thread& thread : threads) thread.join();
+
+    std::set<uint64_t> unique;
+    for (const auto& ids : generated) unique.insert(ids.begin(), ids.end());
+    assert(unique.size() == THREADS * PER_THREAD);
+}
+
+}  // namespace
+
+int main() {
+    testFields();
+    testClientOrderId();
+    testConcurrentUnique();
+    std::cout << "order_id_test: OK" << std::endl;
+    return 0;
+}
@@ -0,0 +1,98 @@
+// 價格通道測試：合併時每個交易對只交付最新一筆並計入被合併的筆數，過時事件只計一次；不合併時逐筆依序交付
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "../price_channel.h"
+
+namespace {
+
+PriceEvent event(uint32_t pair, uint64_t sequence) {
+    return PriceEvent{pair, sequence, 3000.0 + static_cast<double>(sequence), 0, 0, 0};
+}
+
+void testConflation() {
+    PriceChannel channel(2, 2, true);
+    std::vector<PriceEvent> batch;
+    assert(channel.consume(batch, 16) == 0);
+
+    // 佇列容量2：1、2 進佇列，3 到 5 寫入最新值槽位，只保留 5
+    for (uint64_t sequence = 1; sequence <= 5; sequence++) {
+        channel.publish(event(0, sequence));
+    }
+    assert(channel.consume(batch, 16) == 1);
+    assert(batch[0].pair == 0 && batch[0].sequence == 5 && batch[0].price == 3005.0);
+    assert(channel.conflatedCount(0) == 4);
+
+    // 另一個交易對不受影響
+    channel.publish(event(1, 1));
+    assert(channel.consume(batch, 16) == 1);
+    assert(batch[0].pair == 1 && channel.conflatedCount(1) == 0);
+    assert(channel.conflatedCount(0) == 4);
+
+    // 未溢出時逐筆交付，不增加合併計數
+    channel.publish(event(0, 6));
+    channel.publish(event(1, 2));
+    assert(channel.consume(batch, 16) == 2);
+    assert(batch[0].sequence == 6 && batch[1].sequence == 2);
+    assert(channel.conflatedCount(0) == 4 && channel.conflatedCount(1) == 0);
+}
+
+void testStaleQueuedEvent() {
+    PriceChannel channel(2, 1, true);
+    std::vector<PriceEvent> batch;
+    // 7、8 進佇列，9 寫入槽位；本批只取出佇列中的 7，再由槽位的 9 取代
+    for (uint64_t sequence = 7; sequence <= 9; sequence++) {
+        channel.publish(event(0, sequence));
+    }
+    assert(channel.consume(batch, 1) == 1);
+    assert(batch[0].sequence == 9);
+    assert(channel.conflatedCount(0) == 8);
+
+    // 仍留在佇列中的 8 已過時：丟棄且不重複計數
+    assert(channel.consume(batch, 16) == 0);
+    assert(channel.conflatedCount(0) == 8);
+    channel.publish(event(0, 10));
+    assert(channel.consume(batch, 16) == 1 && batch[0].sequence == 10);
+    assert(channel.conflatedCount(0) == 8);
+}
+
+void testLossless() {
+    constexpr uint64_t COUNT = 100000;
+    PriceChannel channel(8, 2, false);
+    std::thread producer([&channel]() {
+        for (uint64_t sequence = 1; sequence <= COUNT; sequence++) {
+            channel.publish(event(static_cast<uint32_t>(sequence % 2), (sequence + 1) / 2));
+        }
+    });
+    std::vector<PriceEvent> batch;
+    std::vector<uint64_t> expected = {1, 1};
+    uint64_t received = 0;
+    IdleBackoff backoff(std::chrono::microseconds(50));
+    while (received < COUNT) {
+        if (channel.consume(batch, 4) == 0) {
+            backoff.idle();
+            continue;
+        }
+        backoff.reset();
+        for (const PriceEvent& item : batch) {
+            assert(item.sequence == expected[item.pair]);
+            expected[item.pair]++;
+            received++;
+        }
+    }
+    producer.join();
+    assert(channel.conflatedCount(0) == 0 && channel.conflatedCount(1) == 0);
+}
+
+}  // namespace
+
+int main() {
+    testConflation();
+    testStaleQueuedEvent();
+    testLossless();
+    std::cout << "price_channel_test: OK" << std::endl;
+    return 0;
+}
@@ -0,0 +1,91 @@
+// 順序鎖測試：未發布時讀到全零、讀取端總是讀到某一次完整的發布，且發布次序不倒退
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "../seqlock.h"
+
+namespace {
+
+// 跨越多個字組的值，各欄位由同一個計數推導，讀到混合的發布時必定不一致
+struct Sample {
+    uint64_t count;
+    double price;
+    uint64_t inverted;
+    uint32_t low;
+    char tag[13];
+};
+
+Sample sample(uint64_t count) {
+    Sample value{count, static_cast<double>(count) * 0.25, ~count, static_cast<uint32_t>(count), {}};
+    for (size_t i = 0; i < sizeof(value.tag) - 1; i++) {
+        value.tag[i] = static_cast<char>('a' + (count + i) % 26);
+    }
+    return value;
+}
+
+bool consistent(const Sample& value) {
+    Sample expected = sample(value.count);
+    if (value.price != expected.price || value.inverted != expected.inverted || value.low != expected.low) {
+        return false;
+    }
+    for (size_t i = 0; i < sizeof(value.tag); i++) {
+        if (value.tag[i] != expected.tag[i]) return false;
+    }
+    return true;
+}
+
+void testSingleThread() {
+    SeqlockSlot<Sample> slot;
+    Sample initial = slot.read();
+    assert(initial.count == 0 && initial.price == 0 && initial.inverted == 0 && initial.tag[0] == '\0');
+
+    slot.publish(sample(42));
+    assert(consistent(slot.read()) && slot.read().count == 42);
+    slot.publish(sample(43));
+    assert(slot.read().count == 43);
+}
+
+void testConcurrentReaders() {
+    constexpr uint64_t PUBLISHES = 200000;
+    constexpr size_t READERS = 2;
+    SeqlockSlot<Sample> slot;
+    slot.publish(sample(1));
+    std::atomic<bool> done(false);
+    std::vector<uint64_t> reads(READERS, 0);
+
+    std::vector<std::thread> readers;
+    for (size_t r = 0; r < READERS; r++) {
+        readers.emplace_back([&slot, &done, &reads, r]() {
+            uint64_t last = 0;
+            while (!done.load(std::memory_order_acquire)) {
+                Sample value = slot.read();
+                assert(consistent(value));
+                assert(value.count >= last);
+                last = value.count;
+                reads[r]++;
+                std::this_thread::yield();
+            }
+        });
+    }
+    for (uint64_t count = 2; count <= PUBLISHES; count++) {
+        slot.publish(sample(count));
+        if (count % 64 == 0) std::this_thread::yield();
+    }
+    done.store(true, std::memory_order_release);
+    for (std::thread& reader : readers) reader.join();
+
+    assert(slot.read().count == PUBLISHES);
+    for (uint64_t count : reads) assert(count > 0);
+}
+
+}  // namespace
+
+int main() {
+    testSingleThread();
+    testConcurrentReaders();
+    std::cout << "seqlock_test: OK" << std::endl;
+    return 0;
+}
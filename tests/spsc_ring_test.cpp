@@ -0,0 +1,111 @@
+// 單生產者單消費者環形佇列測試：滿與空的邊界、索引跨過槽位末端的回繞，以及跨執行緒依序交付
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "../spsc_ring.h"
+
+namespace {
+
+std::vector<int> popBatch(SpscRing<int>& ring, size_t maxItems) {
+    std::vector<int> items;
+    ring.popBatch([&items](int value) { items.push_back(value); }, maxItems);
+    return items;
+}
+
+// 反覆取出直到佇列為空（消費者快取的寫入索引用完才重新讀取，單批可能不含最新寫入的項）
+std::vector<int> popAll(SpscRing<int>& ring) {
+    std::vector<int> items;
+    while (ring.popBatch([&items](int value) { items.push_back(value); }, 16) > 0) {}
+    return items;
+}
+
+void testCapacity() {
+    for (size_t capacity : {0, 1, 3, 6, 100}) {
+        bool threw = false;
+        try {
+            SpscRing<int> ring(capacity);
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+    assert(SpscRing<int>(8).capacity() == 8);
+}
+
+void testFullAndEmpty() {
+    SpscRing<int> ring(4);
+    assert(popAll(ring).empty());
+    assert(ring.sizeApprox() == 0);
+
+    for (int i = 0; i < 4; i++) {
+        assert(ring.tryPush(i));
+    }
+    // 已滿：寫入失敗且不覆蓋未讀的項
+    assert(!ring.tryPush(99));
+    assert(ring.sizeApprox() == 4);
+
+    // 取出一項後恰好騰出一個位置
+    assert((popBatch(ring, 1) == std::vector<int>{0}));
+    assert(ring.tryPush(4));
+    assert(!ring.tryPush(5));
+    assert((popAll(ring) == std::vector<int>{1, 2, 3, 4}));
+    assert(popAll(ring).empty());
+}
+
+void testWrapAround() {
+    SpscRing<int> ring(4);
+    int next = 0;
+    int expected = 0;
+    // 每輪寫入3項、取出3項，寫入位置逐輪錯開並多次跨過槽位末端
+    for (int round = 0; round < 10; round++) {
+        for (int i = 0; i < 3; i++) {
+            assert(ring.tryPush(next++));
+        }
+        std::vector<int> items = popBatch(ring, 2);
+        items.push_back(popBatch(ring, 1).at(0));
+        for (int value : items) {
+            assert(value == expected++);
+        }
+    }
+    assert(popAll(ring).empty());
+}
+
+void testConcurrentOrder() {
+    constexpr uint64_t COUNT = 200000;
+    SpscRing<uint64_t> ring(64);
+    std::thread producer([&ring]() {
+        for (uint64_t i = 0; i < COUNT; i++) {
+            while (!ring.tryPush(i)) std::this_thread::yield();
+        }
+    });
+    uint64_t expected = 0;
+    IdleBackoff backoff(std::chrono::microseconds(50));
+    while (expected < COUNT) {
+        size_t count = ring.popBatch([&expected](uint64_t value) {
+            assert(value == expected);
+            expected++;
+        }, 16);
+        if (count == 0) {
+            backoff.idle();
+        } else {
+            backoff.reset();
+        }
+    }
+    producer.join();
+    assert(ring.sizeApprox() == 0);
+}
+
+}  // namespace
+
+int main() {
+    testCapacity();
+    testFullAndEmpty();
+    testWrapAround();
+    testConcurrentOrder();
+    std::cout << "spsc_ring_test: OK" << std::endl;
+    return 0;
+}
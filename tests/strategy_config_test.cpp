@@ -0,0 +1,120 @@
+// 配置校驗測試：非法取值在解析時以 std::runtime_error 拒絕，訊息指出是哪個鍵
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include "../strategy_config.h"
+#include "../volatility.h"
+
+namespace {
+
+nlohmann::json baseConfig() {
+    return nlohmann::json{
+        {"trading_pair", "ETHUSDT"},
+        {"grid_spacing", 1.0},
+        {"grid_count", 5},
+        {"min_order_quantity", 0.01},
+        {"initial_investment", 1000.0},
+        {"max_position_size", 10.0},
+        {"max_drawdown_percent", 0.1},
+        {"max_loss_per_trade_percent", 0.02},
+        {"update_interval_seconds", 1},
+        {"log_file_path", "trading_log.txt"}};
+}
+
+// 解析配置，回傳錯誤訊息，合法時為空
+std::string parseError(const nlohmann::json& json) {
+    try {
+        StrategyConfig::fromJson(json);
+    } catch (const std::runtime_error& error) {
+        return error.what();
+    }
+    return "";
+}
+
+// 週期非法時拋出 "Invalid kline interval"
+bool rejectsInterval(const std::string& interval) {
+    try {
+        klineIntervalMs(interval);
+    } catch (const std::runtime_error& error) {
+        return std::string(error.what()).find("Invalid kline interval") != std::string::npos;
+    }
+    return false;
+}
+
+void testKlineInterval() {
+    assert(klineIntervalMs("1s") == 1000);
+    assert(klineIntervalMs("15m") == 15 * 60 * 1000LL);
+    assert(klineIntervalMs("4h") == 4 * 60 * 60 * 1000LL);
+    assert(klineIntervalMs("1w") == 7 * 24 * 60 * 60 * 1000LL);
+
+    for (const char* interval : {"", "m", "1", "0m", "00h", "-1m", "+1m", " 1m", "1xm", "1.5h", "1M",
+                                 "99999999999999999999m"}) {
+        assert(rejectsInterval(interval));
+    }
+
+    nlohmann::json json = baseConfig();
+    json["volatility_kline_interval"] = "0m";
+    assert(parseError(json).find("Invalid kline interval") != std::string::npos);
+    json["volatility_kline_interval"] = "-5m";
+    assert(parseError(json).find("Invalid kline interval") != std::string::npos);
+    json["volatility_kline_interval"] = "5m";
+    assert(parseError(json).empty());
+}
+
+void testGridCount() {
+    nlohmann::json json = baseConfig();
+    for (long long count : {0LL, -1LL, 10001LL, 4294967301LL}) {
+        json["grid_count"] = count;
+        assert(parseError(json).find("grid_count") != std::string::npos);
+    }
+    // 超出 long long 的整數不會被截斷成合法值
+    json["grid_count"] = 18446744073709551615ULL;
+    assert(parseError(json).find("grid_count") != std::string::npos);
+    json["grid_count"] = 10000;
+    assert(parseError(json).empty());
+}
+
+template <typename Function>
+bool throwsRuntimeError(Function function) {
+    try {
+        function();
+    } catch (const std::runtime_error&) {
+        return true;
+    }
+    return false;
+}
+
+void testDecimalRange() {
+    nlohmann::json json = baseConfig();
+    json["price_decimal_places"] = 6;
+    json["quantity_decimal_places"] = 6;
+    assert(parseError(json).find("Unsupported decimal places") != std::string::npos);
+    json["quantity_decimal_places"] = 4;
+    assert(parseError(json).empty());
+
+    // 超出 int64 的轉換與乘積拋出例外，不會溢位成錯誤的值
+    DecimalScale scale(2, 8);
+    assert(scale.toPrice(65000.12) == Price::fromUnits(6500012));
+    assert(throwsRuntimeError([&scale]() { scale.toPrice(1e17); }));
+    assert(throwsRuntimeError([&scale]() { scale.toNotional(1e9); }));
+    assert(throwsRuntimeError([&scale]() { scale.toQuantity(std::nan("")); }));
+    assert(throwsRuntimeError([&scale]() { scale.toPrice(std::numeric_limits<double>::infinity()); }));
+    assert(scale.toPrice(65000) * scale.toQuantity(100) == scale.toNotional(6500000));
+    assert(throwsRuntimeError([&scale]() { return scale.toPrice(1e7) * scale.toQuantity(1e4); }));
+    // 價格超出範圍的配置在解析時拒絕
+    json["initial_investment"] = 1e30;
+    assert(parseError(json).find("out of range") != std::string::npos);
+}
+
+}  // namespace
+
+int main() {
+    testKlineInterval();
+    testGridCount();
+    testDecimalRange();
+    std::cout << "strategy_config_test: OK" << std::endl;
+    return 0;
+}
@@ -0,0 +1,187 @@
+#pragma once
+
+#include <charconv>
+#include <cstdint>
+#include <cstdlib>
+#include <string_view>
+
+/**
+ * @brief 行情回應的專用解析器
+ *
+ * 只處理 /api/v3/ticker/price 的固定形狀：
+ *   {"symbol":"ETHUSDT","price":"3838.01000000"}
+ * 直接掃描接收緩衝區，不建立JSON樹、不分配堆記憶體。
+ * 遇到非預期形狀（非字串值、跳脫字元、缺少欄位等）回傳失敗，
+ * 由呼叫者退回完整JSON解析。
+ */
+class TickerParser {
+public:
+    /**
+     * @brief 解析單一行情物件
+     * @param body 回應內容
+     * @param symbol 輸出交易對名稱，指向 body 內部
+     * @param priceText 輸出價格原始文字，指向 body 內部
+     * @param price 輸出價格
+     * @return 是否解析成功
+     */
+    static bool parse(std::string_view body, std::string_view& symbol,
+                      std::string_view& priceText, double& price) {
+        const char* p = body.data();
+        const char* end = p + body.size();
+        p = parseObject(p, end, symbol, priceText, price);
+        if (!p) return false;
+        p = skipSpace(p, end);
+        return p == end;
+    }
+
+    /**
+     * @brief 解析行情物件陣列，每個元素回調一次 onTicker(symbol, price)
+     * @return 是否整個陣列都解析成功
+     */
+    template <typename Handler>
+    static bool parseArray(std::string_view body, Handler&& onTicker) {
+        const char* p = body.data();
+        const char* end = p + body.size();
+        p = skipSpace(p, end);
+        if (p == end || *p != '[') return false;
+        p = skipSpace(p + 1, end);
+        if (p != end && *p == ']') {
+            return skipSpace(p + 1, end) == end;
+        }
+
+        while (p != end) {
+            std::string_view symbol, priceText;
+            double price = 0;
+            p = parseObject(p, end, symbol, priceText, price);
+            if (!p) return false;
+            onTicker(symbol, price);
+
+            p = skipSpace(p, end);
+            if (p == end) return false;
+            if (*p == ']') {
+                return skipSpace(p + 1, end) == end;
+            }
+            if (*p != ',') return false;
+            p = skipSpace(p + 1, end);
+        }
+        return false;
+    }
+
+    /**
+     * @brief 解析十進位數字文字（例如："3838.01000000"）
+     */
+    static bool parseDecimal(std::string_view text, double& out) {
+        const char* first = text.data();
+        const char* last = first + text.size();
+        if (first == last) return false;
+
+        // 快速路徑：尾數不超過2^53且小數位不超過22時，一次除法即為正確捨入
+        uint64_t mantissa = 0;
+        int digits = 0;
+        int fractionDigits = 0;
+        bool seenDot = false;
+        bool seenDigit = false;
+        const char* p = first;
+        for (; p != last; ++p) {
+            char c = *p;
+            if (c >= '0' && c <= '9') {
+                seenDigit = true;
+                if (mantissa == 0 && c == '0') {
+                    if (seenDot) fractionDigits++;
+                    continue;
+                }
+                if (++digits > 15) break;
+                mantissa = mantissa * 10 + static_cast<uint64_t>(c - '0');
+                if (seenDot) fractionDigits++;
+            } else if (c == '.' && !seenDot) {
+                seenDot = true;
+            } else {
+                return false;
+            }
+        }
+        if (!seenDigit) return false;
+        if (p == last && fractionDigits <= 22) {
+            static const double POW10[] = {
+                1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+            };
+            out = static_cast<double>(mantissa) / POW10[fractionDigits];
+            return true;
+        }
+        return parseDecimalSlow(first, last, out);
+    }
+
+private:
+    static const char* skipSpace(const char* p, const char* end) {
+        while (p != end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t')) ++p;
+        return p;
+    }
+
+    // 讀取不含跳脫字元的字串，p 指向開頭引號
+    static const char* parseString(const char* p, const char* end, std::string_view& out) {
+        if (p == end || *p != '"') return nullptr;
+        const char* start = ++p;
+        while (p != end && *p != '"') {
+            if (*p == '\\') return nullptr;
+            ++p;
+        }
+        if (p == end) return nullptr;
+        out = std::string_view(start, static_cast<size_t>(p - start));
+        return p + 1;
+    }
+
+    // 解析 {"key":"value",...}，只接受字串值，必須包含 symbol 與 price
+    static const char* parseObject(const char* p, const char* end, std::string_view& symbol,
+                                   std::string_view& priceText, double& price) {
+        p = skipSpace(p, end);
+        if (p == end || *p != '{') return nullptr;
+        p = skipSpace(p + 1, end);
+
+        bool hasSymbol = false;
+        bool hasPrice = false;
+        while (p != end && *p != '}') {
+            std::string_view key, value;
+            p = parseString(p, end, key);
+            if (!p) return nullptr;
+            p = skipSpace(p, end);
+            if (p == end || *p != ':') return nullptr;
+            p = parseString(skipSpace(p + 1, end), end, value);
+            if (!p) return nullptr;
+
+            if (key == "symbol") {
+                symbol = value;
+                hasSymbol = true;
+            } else if (key == "price") {
+                if (!parseDecimal(value, price)) return nullptr;
+                priceText = value;
+                hasPrice = true;
+            }
+
+            p = skipSpace(p, end);
+            if (p != end && *p == ',') {
+                p = skipSpace(p + 1, end);
+            } else if (p == end || *p != '}') {
+                return nullptr;
+            }
+        }
+        if (p == end || !hasSymbol || !hasPrice) return nullptr;
+        return p + 1;
+    }
+
+    static bool parseDecimalSlow(const char* first, const char* last, double& out) {
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        auto result = std::from_chars(first, last, out);
+        return result.ec == std::errc() && result.ptr == last;
+#else
+        // 標準庫尚未提供浮點 from_chars 時，複製到棧上緩衝區以 strtod 解析
+        char buffer[64];
+        size_t len = static_cast<size_t>(last - first);
+        if (len >= sizeof(buffer)) return false;
+        for (size_t i = 0; i < len; i++) buffer[i] = first[i];
+        buffer[len] = '\0';
+        char* parsedEnd = nullptr;
+        out = std::strtod(buffer, &parsedEnd);
+        return parsedEnd == buffer + len;
+#endif
+    }
+};
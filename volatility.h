@@ -0,0 +1,301 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * @brief K線
+ */
+struct Kline {
+    long long openTime;  // 開盤時間（毫秒）
+    double open;
+    double high;
+    double low;
+    double close;
+};
+
+/**
+ * @brief 將 Binance K線週期（例如："1m", "15m", "1h", "1d"）轉為毫秒
+ *
+ * 數字部分必須全部是十進位數字且為 1 到 1000000 之間，"0m"、"-1m"、"+1m" 與 "1xm" 都視為非法；
+ * 週期會被用作取模與分頁的除數，不能為0或負數。
+ * @throws std::runtime_error 週期格式非法
+ */
+inline long long klineIntervalMs(const std::string& interval) {
+    static constexpr long long MAX_COUNT = 1000000;
+    long long unitMs = 0;
+    switch (interval.empty() ? '\0' : interval.back()) {
+        case 's': unitMs = 1000LL; break;
+        case 'm': unitMs = 60 * 1000LL; break;
+        case 'h': unitMs = 60 * 60 * 1000LL; break;
+        case 'd': unitMs = 24 * 60 * 60 * 1000LL; break;
+        case 'w': unitMs = 7 * 24 * 60 * 60 * 1000LL; break;
+        default:
+            throw std::runtime_error("Invalid kline interval: " + interval);
+    }
+    std::string digits = interval.substr(0, interval.size() - 1);
+    long long count = 0;
+    for (char c : digits) {
+        if (c < '0' || c > '9' || count > MAX_COUNT) {
+            throw std::runtime_error("Invalid kline interval: " + interval);
+        }
+        count = count * 10 + (c - '0');
+    }
+    if (count <= 0 || count > MAX_COUNT) {
+        throw std::runtime_error("Invalid kline interval: " + interval);
+    }
+    return count * unitMs;
+}
+
+/**
+ * @brief 指數加權移動方差（RiskMetrics）
+ */
+class EwmaVariance {
+private:
+    double lambda;
+    double variance;
+    bool initialized;
+
+public:
+    explicit EwmaVariance(double decay = 0.94)
+        : lambda(decay), variance(0), initialized(false) {}
+
+    void update(double value) {
+        double squared = value * value;
+        variance = initialized ? lambda * variance + (1 - lambda) * squared : squared;
+        initialized = true;
+    }
+
+    bool isReady() const { return initialized; }
+    double value() const { return variance; }
+};
+
+/**
+ * @brief Welford 線上均值與方差
+ */
+class WelfordVariance {
+private:
+    uint64_t count;
+    double mean;
+    double m2;
+
+public:
+    WelfordVariance() : count(0), mean(0), m2(0) {}
+
+    void update(double value) {
+        count++;
+        double delta = value - mean;
+        mean += delta / static_cast<double>(count);
+        m2 += delta * (value - mean);
+    }
+
+    uint64_t size() const { return count; }
+    double getMean() const { return mean; }
+    double variance() const { return count > 1 ? m2 / static_cast<double>(count - 1) : 0; }
+};
+
+/**
+ * @brief 固定窗口的已實現波動率（收益率平方和的環形緩衝區）
+ *
+ * 每次更新加入新值並扣除被擠出的舊值；環形緩衝區每繞一圈重算一次總和，
+ * 以攤銷O(1)的代價消除浮點累積誤差。
+ */
+class RollingRealizedVolatility {
+private:
+    std::vector<double> squares;
+    size_t head;
+    size_t count;
+    double sumSquares;
+
+public:
+    explicit RollingRealizedVolatility(size_t window)
+        : squares(window, 0), head(0), count(0), sumSquares(0) {
+        if (window == 0) {
+            throw std::runtime_error("Realized volatility window must be positive");
+        }
+    }
+
+    void update(double value) {
+        double squared = value * value;
+        sumSquares += squared - squares[head];
+        squares[head] = squared;
+        head = (head + 1) % squares.size();
+        if (count < squares.size()) count++;
+
+        if (head == 0) {
+            sumSquares = 0;
+            for (double s : squares) sumSquares += s;
+        }
+    }
+
+    size_t window() const { return squares.size(); }
+    bool isReady() const { return count == squares.size(); }
+    double value() const { return count > 0 ? std::sqrt(sumSquares / static_cast<double>(count)) : 0; }
+};
+
+/**
+ * @brief 平均真實波幅（Wilder平滑）
+ */
+class AverageTrueRange {
+private:
+    int period;
+    int count;
+    double atr;
+    double previousClose;
+
+public:
+    explicit AverageTrueRange(int n = 14)
+        : period(n), count(0), atr(0), previousClose(0) {}
+
+    void update(const Kline& bar) {
+        double trueRange = bar.high - bar.low;
+        if (count > 0) {
+            trueRange = std::max(trueRange, std::max(std::abs(bar.high - previousClose),
+                                                     std::abs(bar.low - previousClose)));
+        }
+        previousClose = bar.close;
+        count++;
+
+        // 前 period 根取簡單平均，之後改為Wilder平滑
+        if (count <= period) {
+            atr += (trueRange - atr) / count;
+        } else {
+            atr = (atr * (period - 1) + trueRange) / period;
+        }
+    }
+
+    bool isReady() const { return count >= period; }
+    double value() const { return atr; }
+};
+
+/**
+ * @brief 增量波動率估計器
+ *
+ * 逐筆價格聚合成K線，每根K線收盤時以O(1)更新EWMA方差、Welford方差、
+ * ATR 與各窗口的已實現波動率；查詢只讀取已保存的狀態，不回看歷史。
+ * 收益率以K線收盤價的對數收益率計算，與行情推送頻率無關。
+ */
+class VolatilityEstimator {
+public:
+    enum class Source { Atr, Ewma, Realized };
+
+private:
+    long long intervalMs;
+    Source source;
+    EwmaVariance ewma;
+    WelfordVariance welford;
+    AverageTrueRange atr;
+    std::vector<RollingRealizedVolatility> realized;
+    Kline current;
+    bool hasCurrent;
+    double lastClose;
+    double lastPrice;
+
+public:
+    /**
+     * @param klineInterval K線週期（例如："1m"）
+     * @param volatilitySource 驅動網格間距的來源："atr"、"ewma" 或 "realized"
+     * @param lambda EWMA 衰減係數
+     * @param atrPeriod ATR 週期
+     * @param realizedWindows 已實現波動率窗口（K線根數），第一個用於驅動網格間距
+     */
+    VolatilityEstimator(const std::string& klineInterval, const std::string& volatilitySource,
+                        double lambda, int atrPeriod, const std::vector<size_t>& realizedWindows)
+        : intervalMs(klineIntervalMs(klineInterval))
+        , source(parseSource(volatilitySource))
+        , ewma(lambda)
+        , atr(atrPeriod)
+        , current{0, 0, 0, 0, 0}
+        , hasCurrent(false)
+        , lastClose(0)
+        , lastPrice(0) {
+        for (size_t window : realizedWindows) {
+            realized.emplace_back(window);
+        }
+        if (source == Source::Realized && realized.empty()) {
+            throw std::runtime_error("realized volatility source requires at least one window");
+        }
+    }
+
+    /**
+     * @brief 處理一筆價格，跨越K線邊界時收盤上一根
+     * @param price 最新價格
+     * @param timeMs 價格時間（毫秒）
+     */
+    void onTick(double price, long long timeMs) {
+        lastPrice = price;
+        long long openTime = timeMs - timeMs % intervalMs;
+
+        if (hasCurrent && openTime > current.openTime) {
+            addKline(current);
+            hasCurrent = false;
+        }
+        if (!hasCurrent) {
+            current = Kline{openTime, price, price, price, price};
+            hasCurrent = true;
+            return;
+        }
+        current.high = std::max(current.high, price);
+        current.low = std::min(current.low, price);
+        current.close = price;
+    }
+
+    /**
+     * @brief 加入一根已收盤的K線（逐筆聚合或歷史回補）
+     */
+    void addKline(const Kline& bar) {
+        if (lastClose > 0 && bar.close > 0) {
+            double logReturn = std::log(bar.close / lastClose);
+            ewma.update(logReturn);
+            welford.update(logReturn);
+            for (auto& window : realized) {
+                window.update(logReturn);
+            }
+        }
+        atr.update(bar);
+        lastClose = bar.close;
+        if (lastPrice == 0) lastPrice = bar.close;
+    }
+
+    long long getIntervalMs() const { return intervalMs; }
+
+    // 每根K線的對數收益率標準差
+    double ewmaVolatility() const { return std::sqrt(ewma.value()); }
+    double lifetimeVolatility() const { return std::sqrt(welford.variance()); }
+    double realizedVolatility(size_t index = 0) const { return realized.at(index).value(); }
+    double averageTrueRange() const { return atr.value(); }
+
+    // 所選來源是否已有足夠樣本
+    bool isReady() const {
+        switch (source) {
+            case Source::Atr: return atr.isReady();
+            case Source::Ewma: return ewma.isReady();
+            case Source::Realized: return realized.front().isReady();
+        }
+        return false;
+    }
+
+    /**
+     * @brief 以價格單位表示的波動率（ATR，或收益率波動率乘以最新價）
+     */
+    double priceVolatility() const {
+        switch (source) {
+            case Source::Atr: return atr.value();
+            case Source::Ewma: return ewmaVolatility() * lastPrice;
+            case Source::Realized: return realized.front().value() * lastPrice;
+        }
+        return 0;
+    }
+
+private:
+    static Source parseSource(const std::string& name) {
+        if (name == "atr") return Source::Atr;
+        if (name == "ewma") return Source::Ewma;
+        if (name == "realized") return Source::Realized;
+        throw std::runtime_error("Unknown volatility source: " + name);
+    }
+};